@@ -0,0 +1,37 @@
+#pragma once
+
+#include <chrono>
+
+#include "core/types.hpp"
+#include "world/chunk.hpp"
+
+namespace bench
+{
+
+// every benchmark prints its timings and returns false when the paths it
+// compares disagree
+bool faceMasks();
+bool raycast();
+bool spatialHash();
+
+inline f64 getElapsedUs(std::chrono::steady_clock::time_point start)
+{
+    std::chrono::duration<f64, std::micro> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// splitmix64, so synthetic worlds are the same on every run
+inline u64 mixBits(u64 bits)
+{
+    bits += 0x9E3779B97F4A7C15ull;
+    bits = (bits ^ (bits >> 30)) * 0xBF58476D1CE4E5B9ull;
+    bits = (bits ^ (bits >> 27)) * 0x94D049BB133111EBull;
+    return bits ^ (bits >> 31);
+}
+
+// jagged hills with caves, sea, beaches, trees and flowers, so every
+// kind of block the benchmarks tell apart shows up
+void generateTerrain(wld::Chunk &chunk, int chunkX, int chunkZ);
+
+} // namespace bench
\ No newline at end of file
@@ -0,0 +1,279 @@
+#include "bench.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "world/world.hpp"
+#include "world/chunk.hpp"
+#include "world/chunk_mesh.hpp"
+#include "world/face_masks.hpp"
+#include "world/block_registry.hpp"
+
+namespace bench
+{
+
+namespace
+{
+
+using wld::BlockType;
+using wld::Chunk;
+using wld::Face;
+
+constexpr int GRID = 6;
+constexpr int ROUNDS = 8;
+
+constexpr int ROWS = Chunk::CHUNK_HEIGHT * Chunk::CHUNK_SIZE;
+
+struct Neighbor
+{
+    Face face;
+    glm::ivec3 offset;
+};
+
+// the order FaceMasks results are stored in below
+const std::array<Neighbor, 6> NEIGHBORS = {{
+    {Face::WEST, {-1, 0, 0}},
+    {Face::EAST, {1, 0, 0}},
+    {Face::BOTTOM, {0, -1, 0}},
+    {Face::TOP, {0, 1, 0}},
+    {Face::NORTH, {0, 0, 1}},
+    {Face::SOUTH, {0, 0, -1}}
+}};
+
+// per-face test ChunkMesh::build ran before FaceMasks, kept as the
+// reference the masks have to match
+bool isFaceVisible(
+    const Chunk &chunk,
+    const std::array<const Chunk *, 4> &neighbors,
+    int x,
+    int y,
+    int z,
+    BlockType block
+)
+{
+    BlockType adjacentBlock;
+    bool isChunkBoundary = false;
+
+    if (x < 0) {
+        if (neighbors[0] == nullptr) return true;
+        adjacentBlock = neighbors[0]->getBlock(Chunk::CHUNK_SIZE - 1, y, z);
+        isChunkBoundary = true;
+    } else if (x >= Chunk::CHUNK_SIZE) {
+        if (neighbors[1] == nullptr) return true;
+        adjacentBlock = neighbors[1]->getBlock(0, y, z);
+        isChunkBoundary = true;
+    } else if (z < 0) {
+        if (neighbors[2] == nullptr) return true;
+        adjacentBlock = neighbors[2]->getBlock(x, y, Chunk::CHUNK_SIZE - 1);
+        isChunkBoundary = true;
+    } else if (z >= Chunk::CHUNK_SIZE) {
+        if (neighbors[3] == nullptr) return true;
+        adjacentBlock = neighbors[3]->getBlock(x, y, 0);
+        isChunkBoundary = true;
+    } else if (y < 0 || y >= Chunk::CHUNK_HEIGHT) {
+        return true;
+    } else {
+        adjacentBlock = chunk.getBlock(x, y, z);
+    }
+
+    if (adjacentBlock == BlockType::AIR) {
+        return true;
+    }
+
+    if (wld::BlockRegistry::get().getBlock(adjacentBlock).cross) {
+        return true;
+    }
+
+    wld::Block currentData = wld::BlockRegistry::get().getBlock(block);
+    wld::Block adjacentData = wld::BlockRegistry::get().getBlock(adjacentBlock);
+
+    if (isChunkBoundary && block == adjacentBlock) {
+        return false;
+    }
+
+    if (block == adjacentBlock && currentData.transparency && adjacentData.transparency) {
+        return false;
+    }
+
+    if (currentData.transparency && !adjacentData.transparency) {
+        return false;
+    }
+
+    if (currentData.transparency || adjacentData.transparency) {
+        return true;
+    }
+
+    return false;
+}
+
+// visible faces per row, six rows of face bits then one of cross plants
+using FaceRows = std::vector<u32>;
+
+usize getFaceIndex(int y, int z, usize face)
+{
+    return (static_cast<usize>(y * Chunk::CHUNK_SIZE + z)) * 7 + face;
+}
+
+void buildReference(
+    const Chunk &chunk,
+    const std::array<const Chunk *, 4> &neighbors,
+    FaceRows &faces
+)
+{
+    const auto &registry = wld::BlockRegistry::get();
+
+    for (int y = 0; y < Chunk::CHUNK_HEIGHT; y++) {
+        for (int z = 0; z < Chunk::CHUNK_SIZE; z++) {
+            for (int x = 0; x < Chunk::CHUNK_SIZE; x++) {
+                BlockType block = chunk.getBlock(x, y, z);
+                if (block == BlockType::AIR) {
+                    continue;
+                }
+
+                if (registry.getBlock(block).cross) {
+                    faces[getFaceIndex(y, z, 6)] |= 1u << x;
+                    continue;
+                }
+
+                for (usize i = 0; i < NEIGHBORS.size(); i++) {
+                    glm::ivec3 adjacent = glm::ivec3(x, y, z) + NEIGHBORS[i].offset;
+
+                    if (isFaceVisible(
+                        chunk,
+                        neighbors,
+                        adjacent.x,
+                        adjacent.y,
+                        adjacent.z,
+                        block
+                    )) {
+                        faces[getFaceIndex(y, z, i)] |= 1u << x;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void buildMasks(
+    const Chunk &chunk,
+    const std::array<const Chunk *, 4> &neighbors,
+    wld::FaceMasks &masks,
+    FaceRows &faces
+)
+{
+    masks.build(chunk, neighbors);
+
+    for (int y = 0; y < Chunk::CHUNK_HEIGHT; y++) {
+        for (int z = 0; z < Chunk::CHUNK_SIZE; z++) {
+            for (usize i = 0; i < NEIGHBORS.size(); i++) {
+                faces[getFaceIndex(y, z, i)] = masks.getFaces(y, z, NEIGHBORS[i].face);
+            }
+
+            faces[getFaceIndex(y, z, 6)] = masks.getCross(y, z);
+        }
+    }
+}
+
+usize countBits(const FaceRows &faces)
+{
+    usize count = 0;
+
+    for (u32 bits : faces) {
+        while (bits) {
+            wld::FaceMasks::popLowest(bits);
+            count++;
+        }
+    }
+
+    return count;
+}
+
+} // namespace
+
+bool faceMasks()
+{
+    wld::World world;
+
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    chunks.reserve(GRID * GRID);
+
+    for (int z = 0; z < GRID; z++) {
+        for (int x = 0; x < GRID; x++) {
+            chunks.push_back(std::make_unique<Chunk>(world, wld::ChunkPos(x, z)));
+            generateTerrain(*chunks.back(), x, z);
+        }
+    }
+
+    auto getChunk = [&](int x, int z) -> const Chunk * {
+        if (x < 0 || x >= GRID || z < 0 || z >= GRID) {
+            return nullptr;
+        }
+
+        return chunks[z * GRID + x].get();
+    };
+
+    wld::FaceMasks masks;
+    FaceRows reference(ROWS * 7);
+    FaceRows fromMasks(ROWS * 7);
+
+    f64 referenceUs = 0.0;
+    f64 masksUs = 0.0;
+    usize meshed = 0;
+    usize faces = 0;
+    usize mismatches = 0;
+
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int z = 0; z < GRID; z++) {
+            for (int x = 0; x < GRID; x++) {
+                const Chunk &chunk = *getChunk(x, z);
+
+                // -x, +x, -z, +z, as World hands them to the mesher
+                std::array<const Chunk *, 4> neighbors = {
+                    getChunk(x - 1, z),
+                    getChunk(x + 1, z),
+                    getChunk(x, z - 1),
+                    getChunk(x, z + 1)
+                };
+
+                std::fill(reference.begin(), reference.end(), 0);
+
+                auto start = std::chrono::steady_clock::now();
+                buildReference(chunk, neighbors, reference);
+                referenceUs += getElapsedUs(start);
+
+                start = std::chrono::steady_clock::now();
+                buildMasks(chunk, neighbors, masks, fromMasks);
+                masksUs += getElapsedUs(start);
+
+                meshed++;
+
+                if (round > 0) {
+                    continue;
+                }
+
+                faces += countBits(reference);
+
+                for (usize i = 0; i < reference.size(); i++) {
+                    mismatches += reference[i] != fromMasks[i];
+                }
+            }
+        }
+    }
+
+    std::printf(
+        "%zu chunks, %zu faces: isFaceVisible %.0f us/chunk, "
+        "FaceMasks %.0f us/chunk, %zu mismatched rows\n",
+        meshed / ROUNDS,
+        faces,
+        referenceUs / meshed,
+        masksUs / meshed,
+        mismatches
+    );
+
+    return mismatches == 0;
+}
+
+} // namespace bench
\ No newline at end of file
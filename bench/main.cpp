@@ -0,0 +1,68 @@
+#include "bench.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+
+struct Benchmark
+{
+    const char *name;
+    bool (*run)();
+};
+
+const Benchmark BENCHMARKS[] = {
+    {"face_masks", bench::faceMasks},
+    {"raycast", bench::raycast},
+    {"spatial_hash", bench::spatialHash},
+};
+
+} // namespace
+
+// runs every benchmark, or only the ones named on the command line; the
+// block registry loads assets/config, so run from a directory holding it
+int main(int argc, char **argv)
+{
+    bool passed = true;
+    usize ran = 0;
+
+    for (const auto &benchmark : BENCHMARKS) {
+        bool selected = argc < 2;
+
+        for (int i = 1; i < argc; i++) {
+            selected |= std::strcmp(argv[i], benchmark.name) == 0;
+        }
+
+        if (!selected) {
+            continue;
+        }
+
+        std::cout << "== " << benchmark.name << std::endl;
+        ran++;
+
+        try {
+            if (!benchmark.run()) {
+                std::cerr << benchmark.name << ": paths disagree" << std::endl;
+                passed = false;
+            }
+        } catch (const std::exception &e) {
+            std::cerr << benchmark.name << ": " << e.what() << std::endl;
+            passed = false;
+        }
+    }
+
+    if (ran == 0) {
+        std::cerr << "no benchmark matches, available:";
+
+        for (const auto &benchmark : BENCHMARKS) {
+            std::cerr << " " << benchmark.name;
+        }
+
+        std::cerr << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
@@ -0,0 +1,179 @@
+#include "bench.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "world/world.hpp"
+
+namespace bench
+{
+
+namespace
+{
+
+using wld::Chunk;
+using wld::Face;
+using wld::Ray;
+using wld::RaycastResult;
+
+constexpr int GRID = 8;
+constexpr int ROUNDS = 8;
+constexpr u32 ORIGINS = 16;
+constexpr u32 DIRECTIONS = 1024;
+constexpr f32 MAX_DISTANCE = 64.0f;
+
+// the per-block walk World::raycast ran before column skipping, kept as
+// the reference the batch has to match
+bool walkRay(const wld::World &world, const Ray &ray, RaycastResult &result)
+{
+    glm::vec3 pos = ray.origin;
+    glm::vec3 step = glm::sign(ray.direction);
+    glm::vec3 tDelta = glm::abs(1.0f / ray.direction);
+    glm::vec3 tMax;
+    glm::ivec3 blockPos = glm::floor(pos);
+
+    for (i32 i = 0; i < 3; i++) {
+        if (step[i] > 0) {
+            tMax[i] = ((blockPos[i] + 1) - pos[i]) * tDelta[i];
+        } else {
+            tMax[i] = (pos[i] - blockPos[i]) * tDelta[i];
+        }
+    }
+
+    Face hitFace;
+    f32 dist = 0.0f;
+
+    while (dist < MAX_DISTANCE) {
+        if (tMax.x < tMax.y && tMax.x < tMax.z) {
+            blockPos.x += step.x;
+            dist = tMax.x;
+            tMax.x += tDelta.x;
+            hitFace = (step.x > 0) ? Face::WEST : Face::EAST;
+        } else if (tMax.y < tMax.z) {
+            blockPos.y += step.y;
+            dist = tMax.y;
+            tMax.y += tDelta.y;
+            hitFace = (step.y > 0) ? Face::BOTTOM : Face::TOP;
+        } else {
+            blockPos.z += step.z;
+            dist = tMax.z;
+            tMax.z += tDelta.z;
+            hitFace = (step.z > 0) ? Face::NORTH : Face::SOUTH;
+        }
+
+        if (world.hasFlag(blockPos, wld::BlockFlag::TARGETABLE)) {
+            result.pos = blockPos;
+            result.face = hitFace;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// a fibonacci sphere of directions around every origin, the origins
+// spread over the middle of the grid from the caves to above the trees
+std::vector<Ray> placeRays()
+{
+    std::vector<Ray> rays;
+    rays.reserve(ORIGINS * DIRECTIONS);
+
+    const f32 goldenAngle = 2.39996323f;
+    const f32 extent = GRID * Chunk::CHUNK_SIZE;
+
+    for (u32 i = 0; i < ORIGINS; i++) {
+        u64 bits = mixBits(i);
+
+        auto unit = [&bits]() {
+            f32 value = static_cast<f32>(bits & 0xFFFFF) / 0xFFFFF;
+            bits >>= 20;
+            return value;
+        };
+
+        glm::vec3 origin(
+            (0.25f + unit() * 0.5f) * extent,
+            30.0f + unit() * 50.0f,
+            (0.25f + unit() * 0.5f) * extent
+        );
+
+        for (u32 j = 0; j < DIRECTIONS; j++) {
+            f32 y = 1.0f - 2.0f * (j + 0.5f) / DIRECTIONS;
+            f32 radius = std::sqrt(1.0f - y * y);
+            f32 angle = goldenAngle * j;
+
+            glm::vec3 direction(
+                std::cos(angle) * radius,
+                y,
+                std::sin(angle) * radius
+            );
+
+            rays.push_back({origin, direction});
+        }
+    }
+
+    return rays;
+}
+
+} // namespace
+
+bool raycast()
+{
+    wld::World world;
+
+    for (int z = 0; z < GRID; z++) {
+        for (int x = 0; x < GRID; x++) {
+            generateTerrain(world.addChunk(wld::ChunkPos(x, z)), x, z);
+        }
+    }
+
+    std::vector<Ray> rays = placeRays();
+    std::vector<RaycastResult> reference(rays.size());
+    std::vector<RaycastResult> batch;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int round = 0; round < ROUNDS; round++) {
+        for (usize i = 0; i < rays.size(); i++) {
+            reference[i].hit = walkRay(world, rays[i], reference[i]);
+        }
+    }
+
+    f64 referenceUs = getElapsedUs(start);
+
+    usize hits = 0;
+    start = std::chrono::steady_clock::now();
+
+    for (int round = 0; round < ROUNDS; round++) {
+        hits = world.raycast(rays, MAX_DISTANCE, batch);
+    }
+
+    f64 batchUs = getElapsedUs(start);
+
+    usize mismatches = 0;
+
+    for (usize i = 0; i < rays.size(); i++) {
+        if (reference[i].hit != batch[i].hit) {
+            mismatches++;
+        } else if (reference[i].hit) {
+            mismatches += reference[i].pos != batch[i].pos ||
+                reference[i].face != batch[i].face;
+        }
+    }
+
+    f64 traced = static_cast<f64>(rays.size()) * ROUNDS;
+
+    std::printf(
+        "%zu rays, %.0f%% hit: per-block walk %.2f Mrays/s, "
+        "World::raycast %.2f Mrays/s, %zu mismatches\n",
+        rays.size(),
+        100.0 * hits / rays.size(),
+        traced / referenceUs,
+        traced / batchUs,
+        mismatches
+    );
+
+    return mismatches == 0;
+}
+
+} // namespace bench
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include "bench.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "ecs/systems/physics/spatial_hash.hpp"
+
+namespace bench
+{
+
+namespace
+{
+
+constexpr u32 ROUNDS = 20;
+constexpr u32 CHECKED = 2000;
+constexpr f32 QUERY_RADIUS = 8.0f;
+
+// a player-sized box
+const glm::vec3 HALF_SIZE(0.3f, 0.9f, 0.3f);
+
+struct Box
+{
+    glm::vec3 min;
+    glm::vec3 max;
+};
+
+bool overlaps(const Box &a, const Box &b)
+{
+    return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+        a.min.y <= b.max.y && a.max.y >= b.min.y &&
+        a.min.z <= b.max.z && a.max.z >= b.min.z;
+}
+
+bool withinRadius(const Box &box, const glm::vec3 &center, f32 radius)
+{
+    glm::vec3 offset = glm::clamp(center, box.min, box.max) - center;
+    return glm::dot(offset, offset) <= radius * radius;
+}
+
+// entities spread over a square that keeps the density the same for
+// every count, about one per 16 square blocks
+std::vector<Box> placeEntities(u32 count)
+{
+    std::vector<Box> boxes(count);
+    f32 extent = std::sqrt(static_cast<f32>(count)) * 4.0f;
+
+    for (u32 i = 0; i < count; i++) {
+        u64 bits = mixBits(count * 0x100000000ull + i);
+
+        auto unit = [&bits]() {
+            f32 value = static_cast<f32>(bits & 0xFFFFF) / 0xFFFFF;
+            bits >>= 20;
+            return value;
+        };
+
+        glm::vec3 center(
+            (unit() * 2.0f - 1.0f) * extent,
+            60.0f + unit() * 20.0f,
+            (unit() * 2.0f - 1.0f) * extent
+        );
+
+        boxes[i] = {center - HALF_SIZE, center + HALF_SIZE};
+    }
+
+    return boxes;
+}
+
+// the hash has to report every overlapping entity exactly once, checked
+// against testing every other box
+usize checkQueries(const sys::SpatialHash &hash, const std::vector<Box> &boxes)
+{
+    usize mismatches = 0;
+    std::vector<EntityID> found;
+
+    for (u32 i = 0; i < std::min<u32>(CHECKED, boxes.size()); i++) {
+        const Box &query = boxes[i];
+        glm::vec3 center = (query.min + query.max) * 0.5f;
+
+        found.clear();
+        hash.queryBox(query.min, query.max, [&](EntityID entity) {
+            found.push_back(entity);
+        });
+
+        std::sort(found.begin(), found.end());
+
+        for (u32 j = 0; j < boxes.size(); j++) {
+            bool expected = overlaps(boxes[j], query);
+            bool reported = std::binary_search(found.begin(), found.end(), j);
+            mismatches += expected != reported;
+        }
+
+        mismatches += std::adjacent_find(found.begin(), found.end()) != found.end();
+
+        found.clear();
+        hash.queryRadius(center, QUERY_RADIUS, [&](EntityID entity) {
+            found.push_back(entity);
+        });
+
+        std::sort(found.begin(), found.end());
+
+        for (u32 j = 0; j < boxes.size(); j++) {
+            bool expected = withinRadius(boxes[j], center, QUERY_RADIUS);
+            bool reported = std::binary_search(found.begin(), found.end(), j);
+            mismatches += expected != reported;
+        }
+
+        mismatches += std::adjacent_find(found.begin(), found.end()) != found.end();
+    }
+
+    return mismatches;
+}
+
+} // namespace
+
+bool spatialHash()
+{
+    bool passed = true;
+
+    for (u32 count : {1000u, 10000u, 50000u}) {
+        std::vector<Box> boxes = placeEntities(count);
+        sys::SpatialHash hash;
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (u32 round = 0; round < ROUNDS; round++) {
+            hash.clear();
+
+            for (u32 i = 0; i < count; i++) {
+                hash.insert(i, boxes[i].min, boxes[i].max);
+            }
+
+            hash.build();
+        }
+
+        f64 buildUs = getElapsedUs(start) / ROUNDS;
+
+        // the pair search Physics::separateEntities runs every tick
+        usize pairs = 0;
+        start = std::chrono::steady_clock::now();
+
+        for (u32 i = 0; i < count; i++) {
+            hash.queryBox(boxes[i].min, boxes[i].max, [&](EntityID other) {
+                pairs += other > i;
+            });
+        }
+
+        f64 pairUs = getElapsedUs(start);
+
+        // the same search done brute force, over every pair
+        usize brutePairs = 0;
+        start = std::chrono::steady_clock::now();
+
+        for (u32 i = 0; i < count; i++) {
+            for (u32 j = i + 1; j < count; j++) {
+                brutePairs += overlaps(boxes[i], boxes[j]);
+            }
+        }
+
+        f64 bruteUs = getElapsedUs(start);
+
+        usize mismatches = checkQueries(hash, boxes);
+        mismatches += pairs != brutePairs;
+
+        std::printf(
+            "%6u entities: build %.0f us, %zu pairs in %.0f us "
+            "(brute force %.0f us), %zu mismatches\n",
+            count,
+            buildUs,
+            pairs,
+            pairUs,
+            bruteUs,
+            mismatches
+        );
+
+        passed &= mismatches == 0;
+    }
+
+    return passed;
+}
+
+} // namespace bench
\ No newline at end of file
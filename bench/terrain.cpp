@@ -0,0 +1,80 @@
+#include "bench.hpp"
+
+namespace bench
+{
+
+namespace
+{
+
+using wld::BlockType;
+using wld::Chunk;
+
+constexpr int SEA_LEVEL = 52;
+
+} // namespace
+
+void generateTerrain(Chunk &chunk, int chunkX, int chunkZ)
+{
+    for (int z = 0; z < Chunk::CHUNK_SIZE; z++) {
+        for (int x = 0; x < Chunk::CHUNK_SIZE; x++) {
+            u64 column = mixBits(
+                static_cast<u64>(static_cast<u32>(chunkX * Chunk::CHUNK_SIZE + x)) << 32 |
+                static_cast<u32>(chunkZ * Chunk::CHUNK_SIZE + z)
+            );
+
+            int height = 40 + static_cast<int>(column % 24);
+
+            for (int y = 0; y < height; y++) {
+                BlockType type = BlockType::STONE;
+
+                if (y == 0) {
+                    type = BlockType::BEDROCK;
+                } else if (y == height - 1) {
+                    type = height <= SEA_LEVEL ? BlockType::SAND : BlockType::GRASS;
+                } else if (y >= height - 4) {
+                    type = BlockType::DIRT;
+                } else if (mixBits(column + y) % 8 == 0) {
+                    type = BlockType::AIR;
+                }
+
+                chunk.setBlock(x, y, z, type);
+            }
+
+            for (int y = height; y < SEA_LEVEL; y++) {
+                chunk.setBlock(x, y, z, BlockType::WATER);
+            }
+
+            if (height <= SEA_LEVEL) {
+                continue;
+            }
+
+            u64 decoration = (column >> 40) % 32;
+
+            if (decoration < 2) {
+                chunk.setBlock(x, height, z, decoration ? BlockType::ROSE : BlockType::FLOWER);
+            } else if (decoration == 2) {
+                for (int y = height; y < height + 4; y++) {
+                    chunk.setBlock(x, y, z, BlockType::LOG);
+                }
+
+                for (int y = height + 2; y < height + 5; y++) {
+                    for (int dz = -1; dz <= 1; dz++) {
+                        for (int dx = -1; dx <= 1; dx++) {
+                            if (
+                                (dx == 0 && dz == 0 && y < height + 4) ||
+                                x + dx < 0 || x + dx >= Chunk::CHUNK_SIZE ||
+                                z + dz < 0 || z + dz >= Chunk::CHUNK_SIZE
+                            ) {
+                                continue;
+                            }
+
+                            chunk.setBlock(x + dx, y, z + dz, BlockType::LEAVES);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace bench
\ No newline at end of file
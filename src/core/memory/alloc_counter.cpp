@@ -0,0 +1,54 @@
+#include "alloc_counter.hpp"
+
+#include <new>
+#include <cstdlib>
+
+namespace core
+{
+
+std::atomic<u64> AllocCounter::m_count{0};
+std::atomic<u64> AllocCounter::m_bytes{0};
+
+} // namespace core
+
+void *operator new(std::size_t size)
+{
+    core::AllocCounter::record(size);
+
+    if (size == 0) {
+        size = 1;
+    }
+
+    if (void *ptr = std::malloc(size)) {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t size) noexcept
+{
+    UNUSED(size);
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t size) noexcept
+{
+    UNUSED(size);
+    std::free(ptr);
+}
\ No newline at end of file
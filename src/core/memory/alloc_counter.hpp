@@ -0,0 +1,28 @@
+#pragma once
+
+#include <atomic>
+
+#include "core/types.hpp"
+
+namespace core
+{
+
+class AllocCounter
+{
+
+public:
+    static u64 getCount() { return m_count.load(std::memory_order_relaxed); }
+    static u64 getBytes() { return m_bytes.load(std::memory_order_relaxed); }
+
+    static void record(usize size)
+    {
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+private:
+    static std::atomic<u64> m_count;
+    static std::atomic<u64> m_bytes;
+};
+
+} // namespace core
\ No newline at end of file
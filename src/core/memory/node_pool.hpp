@@ -0,0 +1,109 @@
+#pragma once
+
+#include <vector>
+#include <type_traits>
+
+#include "core/types.hpp"
+
+namespace core
+{
+
+template<typename Container>
+class NodePool
+{
+
+public:
+    using Node = typename Container::node_type;
+    using Key = typename Container::key_type;
+    using Iterator = typename Container::iterator;
+
+    Iterator acquire(Container &container, const Key &key)
+    {
+        if (auto it = container.find(key); it != container.end()) {
+            return it;
+        }
+
+        if (m_free.empty()) {
+            return container.insert(makeValue(key)).first;
+        }
+
+        Node node = std::move(m_free.back());
+        m_free.pop_back();
+
+        if constexpr (IS_SET) {
+            node.value() = key;
+        } else {
+            node.key() = key;
+        }
+
+        return container.insert(std::move(node)).position;
+    }
+
+    void release(Container &container, Iterator it)
+    {
+        if (m_free.size() >= m_limit) {
+            container.erase(it);
+            return;
+        }
+
+        m_free.push_back(container.extract(it));
+    }
+
+    bool release(Container &container, const Key &key)
+    {
+        auto it = container.find(key);
+        if (it == container.end()) {
+            return false;
+        }
+
+        release(container, it);
+        return true;
+    }
+
+    template<typename Fn>
+    void forEach(Fn &&fn)
+    {
+        for (auto &node : m_free) {
+            if constexpr (IS_SET) {
+                fn(node.value());
+            } else {
+                fn(node.mapped());
+            }
+        }
+    }
+
+    void reserve(usize count) { m_free.reserve(count); }
+    void clear() { m_free.clear(); }
+
+    // nodes released past the limit are destroyed instead of kept
+    void setLimit(usize limit)
+    {
+        m_limit = limit;
+
+        if (m_free.size() > limit) {
+            m_free.resize(limit);
+        }
+    }
+
+    usize size() const { return m_free.size(); }
+
+private:
+    static constexpr bool IS_SET = std::is_same_v<
+        typename Container::key_type,
+        typename Container::value_type
+    >;
+
+    static typename Container::value_type makeValue(const Key &key)
+    {
+        if constexpr (IS_SET) {
+            return key;
+        } else {
+            return {key, typename Container::mapped_type()};
+        }
+    }
+
+    std::vector<Node> m_free;
+    usize m_limit = USIZE_MAX;
+};
+
+} // namespace core
\ No newline at end of file
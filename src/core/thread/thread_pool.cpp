@@ -0,0 +1,174 @@
+#include "thread_pool.hpp"
+
+namespace core
+{
+
+thread_local u32 ThreadPool::m_workerIndex = 0;
+
+void ThreadPool::init(u32 threadCount)
+{
+    m_stopping = false;
+
+    for (u32 i = 0; i < threadCount; i++) {
+        m_threads.emplace_back(&ThreadPool::work, this, i + 1);
+    }
+}
+
+void ThreadPool::destroy()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+
+    m_taskReady.notify_all();
+
+    for (auto &thread : m_threads) {
+        thread.join();
+    }
+
+    m_threads.clear();
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    if (m_threads.empty()) {
+        task();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push(std::move(task));
+    }
+
+    m_taskReady.notify_one();
+}
+
+void ThreadPool::wait()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_tasksDone.wait(lock, [&] {
+        return m_tasks.empty() && m_active == 0;
+    });
+
+    if (m_exception) {
+        auto exception = m_exception;
+        m_exception = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+void ThreadPool::parallelFor(
+    usize count,
+    usize grain,
+    const std::function<void(usize, usize)> &body
+)
+{
+    grain = std::max<usize>(grain, 1);
+    const usize chunks = (count + grain - 1) / grain;
+
+    if (chunks <= 1 || m_threads.empty()) {
+        if (count > 0) {
+            body(0, count);
+        }
+        return;
+    }
+
+    struct Batch
+    {
+        std::atomic<usize> next{0};
+        std::atomic<usize> done{0};
+
+        std::mutex mutex;
+        std::condition_variable finished;
+        std::exception_ptr exception;
+    };
+
+    auto batch = std::make_shared<Batch>();
+
+    // helpers that start after every chunk was claimed never touch body
+    auto run = [batch, chunks, count, grain, &body] {
+        while (true) {
+            usize chunk = batch->next++;
+            if (chunk >= chunks) {
+                return;
+            }
+
+            usize begin = chunk * grain;
+            usize end = std::min(begin + grain, count);
+
+            try {
+                body(begin, end);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(batch->mutex);
+                if (!batch->exception) {
+                    batch->exception = std::current_exception();
+                }
+            }
+
+            if (++batch->done == chunks) {
+                std::lock_guard<std::mutex> lock(batch->mutex);
+                batch->finished.notify_all();
+            }
+        }
+    };
+
+    usize helpers = std::min<usize>(chunks - 1, m_threads.size());
+    for (usize i = 0; i < helpers; i++) {
+        submit(run);
+    }
+
+    run();
+
+    std::unique_lock<std::mutex> lock(batch->mutex);
+    batch->finished.wait(lock, [&] {
+        return batch->done == chunks;
+    });
+
+    if (batch->exception) {
+        std::rethrow_exception(batch->exception);
+    }
+}
+
+void ThreadPool::work(u32 index)
+{
+    m_workerIndex = index;
+
+    while (true) {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_taskReady.wait(lock, [&] {
+                return m_stopping || !m_tasks.empty();
+            });
+
+            if (m_stopping && m_tasks.empty()) {
+                return;
+            }
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop();
+            m_active++;
+        }
+
+        try {
+            task();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_exception) {
+                m_exception = std::current_exception();
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_active--;
+        }
+
+        m_tasksDone.notify_all();
+    }
+}
+
+} // namespace core
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <queue>
+#include <atomic>
+#include <algorithm>
+#include <memory>
+
+#include "core/types.hpp"
+
+namespace core
+{
+
+class ThreadPool
+{
+
+public:
+    ThreadPool() = default;
+    ~ThreadPool() = default;
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    void init(u32 threadCount);
+    void destroy();
+
+    void submit(std::function<void()> task);
+    void wait();
+
+    // runs body over [0, count) in chunks of at most grain items on the
+    // calling thread and idle workers, returns once every chunk is done;
+    // unlike wait() it may be called from inside a task
+    void parallelFor(
+        usize count,
+        usize grain,
+        const std::function<void(usize, usize)> &body
+    );
+
+    u32 getThreadCount() const { return static_cast<u32>(m_threads.size()); }
+
+    // 0 on the calling thread, 1..threadCount on workers
+    static u32 getWorkerIndex() { return m_workerIndex; }
+
+private:
+    void work(u32 index);
+
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_mutex;
+    std::condition_variable m_taskReady;
+    std::condition_variable m_tasksDone;
+
+    std::queue<std::function<void()>> m_tasks;
+    u32 m_active = 0;
+    bool m_stopping = false;
+
+    std::exception_ptr m_exception;
+
+    static thread_local u32 m_workerIndex;
+};
+
+} // namespace core
\ No newline at end of file
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "core/types.hpp"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace ecs
+{
+
+// sparse set: a paged entity -> slot table in front of densely packed
+// entities and components, so lookups are two loads and iteration walks
+// contiguous memory
+class ComponentPoolBase
+{
+
+public:
+    virtual ~ComponentPoolBase() = default;
+
+    virtual void remove(EntityID id) = 0;
+
+    bool contains(EntityID id) const { return getSlot(id) != INVALID_SLOT; }
+    usize size() const { return m_entities.size(); }
+
+    const std::vector<EntityID> &getEntities() const { return m_entities; }
+
+protected:
+    static constexpr u32 PAGE_SIZE = 1024;
+    static constexpr u32 INVALID_SLOT = U32_MAX;
+
+    using Page = std::array<u32, PAGE_SIZE>;
+
+    std::vector<std::unique_ptr<Page>> m_pages;
+    std::vector<EntityID> m_entities;
+
+    u32 getSlot(EntityID id) const
+    {
+        usize page = id / PAGE_SIZE;
+        if (page >= m_pages.size() || !m_pages[page]) {
+            return INVALID_SLOT;
+        }
+
+        return (*m_pages[page])[id % PAGE_SIZE];
+    }
+
+    void setSlot(EntityID id, u32 slot)
+    {
+        usize page = id / PAGE_SIZE;
+        if (page >= m_pages.size()) {
+            m_pages.resize(page + 1);
+        }
+
+        if (!m_pages[page]) {
+            m_pages[page] = std::make_unique<Page>();
+            m_pages[page]->fill(INVALID_SLOT);
+        }
+
+        (*m_pages[page])[id % PAGE_SIZE] = slot;
+    }
+};
+
+// pointers into a pool stay valid until a component of the same type is
+// added or removed
+template<typename T>
+class ComponentPool : public ComponentPoolBase
+{
+
+public:
+    T &add(EntityID id)
+    {
+        u32 slot = getSlot(id);
+        if (slot != INVALID_SLOT) {
+            m_components[slot] = T{};
+            return m_components[slot];
+        }
+
+        setSlot(id, static_cast<u32>(m_entities.size()));
+        m_entities.push_back(id);
+        m_components.emplace_back();
+
+        return m_components.back();
+    }
+
+    T *get(EntityID id)
+    {
+        u32 slot = getSlot(id);
+        return slot != INVALID_SLOT ? &m_components[slot] : nullptr;
+    }
+
+    void remove(EntityID id) override
+    {
+        u32 slot = getSlot(id);
+        if (slot == INVALID_SLOT) {
+            return;
+        }
+
+        // swap the last component into the hole to stay dense
+        u32 last = static_cast<u32>(m_entities.size() - 1);
+        if (slot != last) {
+            m_entities[slot] = m_entities[last];
+            m_components[slot] = std::move(m_components[last]);
+            setSlot(m_entities[slot], slot);
+        }
+
+        m_entities.pop_back();
+        m_components.pop_back();
+        setSlot(id, INVALID_SLOT);
+    }
+
+    std::vector<T> &getComponents() { return m_components; }
+
+private:
+    std::vector<T> m_components;
+};
+
+} // namespace ecs
\ No newline at end of file
@@ -5,9 +5,9 @@
 namespace ecs
 {
 
+// plain tag base, components are stored by value in their own pools
 struct Component
 {
-    virtual ~Component() = default;
 };
 
 } // namespace ecs
\ No newline at end of file
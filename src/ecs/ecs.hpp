@@ -2,13 +2,14 @@
 
 #include "core/types.hpp"
 
-#include <unordered_map>
-#include <typeindex>
 #include <memory>
 #include <vector>
 
 #include "components/component.hpp"
 #include "systems/system.hpp"
+#include "component_pool.hpp"
+#include "type_id.hpp"
+#include "view.hpp"
 
 #include "components/physics/transform.hpp"
 
@@ -25,103 +26,103 @@ public:
 
     void destroyEntity(EntityID id)
     {
-        m_components.erase(id);
+        for (auto &pool : m_pools) {
+            if (pool) {
+                pool->remove(id);
+            }
+        }
     }
 
     template<typename T>
     T *addComponent(EntityID id)
     {
-        auto &componentMap = m_components[id];
-        auto typeIndex = std::type_index(typeid(T));
-
-        auto component = std::make_unique<T>();
-        componentMap[typeIndex] = std::move(component);
-
-        return static_cast<T *>(componentMap[typeIndex].get());
+        return &getPool<T>().add(id);
     }
 
     template<typename T>
     T *getComponent(EntityID id)
     {
-        auto &componentMap = m_components[id];
-        auto typeIndex = std::type_index(typeid(T));
-
-        auto iter = componentMap.find(typeIndex);
-        if (iter == componentMap.end()) {
-            return nullptr;
-        }
-
-        return static_cast<T *>(iter->second.get());
+        auto *pool = findPool<T>();
+        return pool ? pool->get(id) : nullptr;
     }
 
     template<typename T>
     void removeComponent(EntityID id)
     {
-        auto &componentMap = m_components[id];
-        auto typeIndex = std::type_index(typeid(T));
-
-        componentMap.erase(typeIndex);
+        if (auto *pool = findPool<T>()) {
+            pool->remove(id);
+        }
     }
 
     template<typename... Components>
-    std::vector<EntityID> view()
+    View<Components...> view()
     {
-        std::vector<EntityID> entities;
+        return View<Components...>(getPool<Components>()...);
+    }
 
-        for (auto &[id, componentMap] : m_components) {
-            if (hasAllComponents<Components...>(id)) {
-                entities.push_back(id);
+    // creates the pools a system declared, so getPool never grows m_pools
+    // while systems tick concurrently
+    void createPools(const Access &access)
+    {
+        for (const auto &pool : access.getPoolTypes()) {
+            if (pool.type >= m_pools.size()) {
+                m_pools.resize(pool.type + 1);
             }
-        }
 
-        return entities;
+            if (!m_pools[pool.type]) {
+                m_pools[pool.type] = pool.create();
+            }
+        }
     }
 
     void storePositions()
     {
-        auto entities = view<cmp::Transform>();
-
-        for (auto &entity : entities) {
-            if (auto transform = getComponent<cmp::Transform>(entity)) {
-                transform->prevPosition = transform->position;
-            }
+        for (auto &transform : getPool<cmp::Transform>().getComponents()) {
+            transform.prevPosition = transform.position;
         }
     }
 
     void interpolate(f32 alpha)
     {
-        auto entities = view<cmp::Transform>();
-
-        for (auto &entity : entities) {
-            if (auto transform = getComponent<cmp::Transform>(entity)) {
-                transform->renderPosition = glm::mix(
-                    transform->prevPosition,
-                    transform->position,
-                    alpha
-                );
-            }
+        for (auto &transform : getPool<cmp::Transform>().getComponents()) {
+            transform.renderPosition = glm::mix(
+                transform.prevPosition,
+                transform.position,
+                alpha
+            );
         }
     }
 
 private:
     EntityID m_nextEntityID = 0;
-    
-    using ComponentMap = std::unordered_map<std::type_index,
-        std::unique_ptr<Component>>;
 
-    std::unordered_map<EntityID, ComponentMap> m_components;
+    // indexed by getTypeID<T>()
+    std::vector<std::unique_ptr<ComponentPoolBase>> m_pools;
 
-    template <typename T>
-    bool hasAllComponents(EntityID id)
+    template<typename T>
+    ComponentPool<T> *findPool()
     {
-        return getComponent<T>(id) != nullptr;
+        u32 type = getTypeID<T>();
+        if (type >= m_pools.size()) {
+            return nullptr;
+        }
+
+        return static_cast<ComponentPool<T> *>(m_pools[type].get());
     }
 
-    template <typename First, typename Second, typename... Rest>
-    bool hasAllComponents(EntityID id)
+    template<typename T>
+    ComponentPool<T> &getPool()
     {
-        return getComponent<First>(id) != nullptr &&
-            hasAllComponents<Second, Rest...>(id);
+        u32 type = getTypeID<T>();
+        if (type >= m_pools.size()) {
+            m_pools.resize(type + 1);
+        }
+
+        if (!m_pools[type]) {
+            m_pools[type] = std::make_unique<ComponentPool<T>>();
+        }
+
+        return static_cast<ComponentPool<T> &>(*m_pools[type]);
     }
 };
 
@@ -0,0 +1,70 @@
+#include "scheduler.hpp"
+#include "ecs.hpp"
+
+namespace ecs
+{
+
+void Scheduler::init(ECS &ecs, core::ThreadPool &workers)
+{
+    m_ecs = &ecs;
+    m_workers = &workers;
+}
+
+void Scheduler::add(System &system)
+{
+    m_ecs->createPools(system.getAccess());
+
+    system.setWorkers(m_workers);
+    m_systems.push_back(&system);
+
+    build();
+}
+
+void Scheduler::tick(f32 dt)
+{
+    for (const auto &stage : m_stages) {
+        if (stage.size() == 1) {
+            stage.front()->tick(dt);
+            continue;
+        }
+
+        for (System *system : stage) {
+            if (!system->getAccess().isMainThread()) {
+                m_workers->submit([system, dt] { system->tick(dt); });
+            }
+        }
+
+        for (System *system : stage) {
+            if (system->getAccess().isMainThread()) {
+                system->tick(dt);
+            }
+        }
+
+        m_workers->wait();
+    }
+}
+
+void Scheduler::build()
+{
+    m_stages.clear();
+
+    std::vector<usize> stages(m_systems.size(), 0);
+
+    for (usize i = 0; i < m_systems.size(); i++) {
+        const Access &access = m_systems[i]->getAccess();
+
+        for (usize j = 0; j < i; j++) {
+            if (access.conflicts(m_systems[j]->getAccess())) {
+                stages[i] = std::max(stages[i], stages[j] + 1);
+            }
+        }
+
+        if (stages[i] >= m_stages.size()) {
+            m_stages.resize(stages[i] + 1);
+        }
+
+        m_stages[stages[i]].push_back(m_systems[i]);
+    }
+}
+
+} // namespace ecs
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+
+#include "core/types.hpp"
+#include "core/thread/thread_pool.hpp"
+#include "systems/system.hpp"
+
+namespace ecs
+{
+
+// ticks systems in stages: a system lands one stage after the latest
+// earlier-registered system it conflicts with, so conflicting systems
+// keep registration order and the result does not depend on timing
+class Scheduler
+{
+
+public:
+    void init(ECS &ecs, core::ThreadPool &workers);
+
+    void add(System &system);
+    void tick(f32 dt);
+
+    usize getStageCount() const { return m_stages.size(); }
+
+private:
+    ECS *m_ecs = nullptr;
+    core::ThreadPool *m_workers = nullptr;
+
+    std::vector<System *> m_systems;
+    std::vector<std::vector<System *>> m_stages;
+
+    void build();
+};
+
+} // namespace ecs
\ No newline at end of file
@@ -7,37 +7,159 @@ namespace sys
 Physics::Physics(ecs::ECS *ecs, wld::World &world)
     : System(ecs), m_world(world)
 {
+    m_access.read<cmp::Player, wld::World>();
+    m_access.write<cmp::Transform, cmp::Velocity, cmp::Collider>();
 }
 
 void Physics::tick(f32 dt)
 {
-    auto entities = m_ecs->view<cmp::Transform, cmp::Velocity>();
+    m_entities.clear();
+
+    for (auto entity : m_ecs->view<cmp::Transform, cmp::Velocity>()) {
+        m_entities.push_back(entity);
+    }
+
+    // entities only read the world and write their own components
+    parallelFor(m_entities.size(), ENTITIES_PER_TASK, [&](usize begin, usize end) {
+        for (usize i = begin; i < end; i++) {
+            tickEntity(m_entities[i], dt);
+        }
+    });
+
+    auto start = std::chrono::steady_clock::now();
+
+    buildBroadphase();
+    separateEntities();
+
+    std::chrono::duration<f32, std::micro> elapsed =
+        std::chrono::steady_clock::now() - start;
+    m_broadphaseTime = elapsed.count();
+}
+
+void Physics::buildBroadphase()
+{
+    m_broadphase.clear();
+
+    for (auto entity : m_entities) {
+        auto *collider = m_ecs->getComponent<cmp::Collider>(entity);
+        if (!collider || collider->isGhost) {
+            continue;
+        }
 
-    for (auto entity : entities) {
         auto *transform = m_ecs->getComponent<cmp::Transform>(entity);
-        auto *velocity = m_ecs->getComponent<cmp::Velocity>(entity);
+        glm::vec3 center = transform->position + collider->offset;
+
+        m_broadphase.insert(
+            entity,
+            center - collider->size * 0.5f,
+            center + collider->size * 0.5f
+        );
+    }
+
+    m_broadphase.build();
+}
+
+void Physics::separateEntities()
+{
+    m_contacts = 0;
+
+    for (auto entity : m_entities) {
         auto *collider = m_ecs->getComponent<cmp::Collider>(entity);
-        auto *player = m_ecs->getComponent<cmp::Player>(entity);
+        if (!collider || collider->isGhost) {
+            continue;
+        }
+
+        auto *transform = m_ecs->getComponent<cmp::Transform>(entity);
 
-        if (player && !player->isFlying) {
-            if (player->isInWater) {
-                velocity->position.y += GRAVITY * 0.3f * dt;
+        glm::vec3 center = transform->position + collider->offset;
+        glm::vec3 half = collider->size * 0.5f;
 
-                velocity->position.x *= 0.8f;
-                velocity->position.y *= 0.9f;
-                velocity->position.z *= 0.8f;
+        m_broadphase.queryBox(center - half, center + half, [&](EntityID other) {
+            // every pair is handled once, from its lower id
+            if (other <= entity) {
+                return;
+            }
+
+            auto *otherCollider = m_ecs->getComponent<cmp::Collider>(other);
+            auto *otherTransform = m_ecs->getComponent<cmp::Transform>(other);
+
+            glm::vec3 otherCenter = otherTransform->position + otherCollider->offset;
+            glm::vec3 otherHalf = otherCollider->size * 0.5f;
+
+            glm::vec3 delta = otherCenter - center;
+            glm::vec3 overlap = half + otherHalf - glm::abs(delta);
+
+            if (overlap.x <= 0.0f || overlap.y <= 0.0f || overlap.z <= 0.0f) {
+                return;
+            }
+
+            m_contacts++;
+
+            glm::vec3 push(0.0f);
+            if (overlap.x < overlap.z) {
+                push.x = (delta.x < 0.0f ? -overlap.x : overlap.x) * 0.5f;
             } else {
-                velocity->position.y += GRAVITY * dt;
+                push.z = (delta.z < 0.0f ? -overlap.z : overlap.z) * 0.5f;
             }
-        } else if (!player) {
-            velocity->position.y += GRAVITY * dt;
-        }
 
-        if (collider && !collider->isGhost) {
-            resolveCollisions(transform, velocity, collider, dt);
+            pushEntity(transform, collider, -push);
+            pushEntity(otherTransform, otherCollider, push);
+        });
+    }
+}
+
+void Physics::pushEntity(
+    cmp::Transform *transform,
+    const cmp::Collider *collider,
+    const glm::vec3 &push
+)
+{
+    glm::vec3 min = transform->position + collider->offset - collider->size * 0.5f;
+    glm::vec3 max = transform->position + collider->offset + collider->size * 0.5f;
+
+    m_pushBlocks.clear();
+    m_world.gatherColliders(
+        glm::min(min, min + push),
+        glm::max(max, max + push),
+        m_pushBlocks
+    );
+
+    glm::vec3 moved;
+
+    for (i32 axis = 0; axis < 3; axis++) {
+        moved[axis] = clipAxis(m_pushBlocks, min, max, axis, push[axis]);
+        min[axis] += moved[axis];
+        max[axis] += moved[axis];
+    }
+
+    transform->position += moved;
+}
+
+void Physics::tickEntity(EntityID entity, f32 dt)
+{
+    auto *transform = m_ecs->getComponent<cmp::Transform>(entity);
+    auto *velocity = m_ecs->getComponent<cmp::Velocity>(entity);
+    auto *collider = m_ecs->getComponent<cmp::Collider>(entity);
+    auto *player = m_ecs->getComponent<cmp::Player>(entity);
+
+    if (player && !player->isFlying) {
+        if (player->isInWater) {
+            velocity->position.y += GRAVITY * 0.3f * dt;
+
+            velocity->position.x *= 0.8f;
+            velocity->position.y *= 0.9f;
+            velocity->position.z *= 0.8f;
         } else {
-            transform->position += velocity->position * dt;
+            velocity->position.y += GRAVITY * dt;
         }
+    } else if (!player) {
+        velocity->position.y += GRAVITY * dt;
+    }
+
+    if (collider && !collider->isGhost) {
+        resolveCollisions(transform, velocity, collider, dt);
+    } else {
+        transform->position += velocity->position * dt;
     }
 }
 
@@ -54,102 +176,117 @@ void Physics::resolveCollisions(
         return;
     }
 
-    glm::vec3 testPos = transform->position;
-    testPos.x += movement.x;
+    glm::vec3 min = transform->position + collider->offset - collider->size * 0.5f;
+    glm::vec3 max = transform->position + collider->offset + collider->size * 0.5f;
 
-    glm::vec3 min = testPos + collider->offset - collider->size * 0.5f;
-    glm::vec3 max = testPos + collider->offset + collider->size * 0.5f;
+    // everything the box can touch this tick, including the ground probe
+    glm::vec3 reachMin = glm::min(min, min + movement);
+    glm::vec3 reachMax = glm::max(max, max + movement);
+    reachMin.y -= collider->groundOffset * 2.0f;
 
-    if (m_world.checkCollision(min, max)) {
-        velocity->position.x = 0.0f;
-        movement.x = 0.0f;
-    } else {
-        transform->position.x = testPos.x;
+    static thread_local std::vector<glm::ivec3> blocks;
+    blocks.clear();
+    m_world.gatherColliders(reachMin, reachMax, blocks);
+
+    glm::vec3 moved = movement;
+
+    for (i32 axis = 0; axis < 3; axis++) {
+        moved[axis] = clipAxis(blocks, min, max, axis, movement[axis]);
+        min[axis] += moved[axis];
+        max[axis] += moved[axis];
     }
 
-    testPos = transform->position;
-    testPos.y += movement.y;
-
-    min = testPos + collider->offset - collider->size * 0.5f;
-    max = testPos + collider->offset + collider->size * 0.5f;
-
-    if (m_world.checkCollision(min, max)) {
-        if (velocity->position.y < 0.0f) {
-            f32 low = transform->position.y;
-            f32 hight = testPos.y;
-            f32 mid;
-            
-            for (int i = 0; i < 10; i++) {
-                mid = (low + hight) * 0.5f;
-                testPos.y = mid;
-
-                min = testPos + collider->offset - collider->size * 0.5f;
-                max = testPos + collider->offset + collider->size * 0.5f;
-
-                if (m_world.checkCollision(min, max)) {
-                    hight = mid;
-                } else {
-                    low = mid;
-                }
-            }
+    transform->position += moved;
 
-            transform->position.y = low;
-            collider->isGrounded = true;
-        } else {
-            f32 low = testPos.y;
-            f32 hight = transform->position.y;
-            f32 mid;
-
-            for (int i = 0; i < 10; i++) {
-                mid = (low + hight) * 0.5f;
-                testPos.y = mid;
-
-                min = testPos + collider->offset - collider->size * 0.5f;
-                max = testPos + collider->offset + collider->size * 0.5f;
-
-                if (m_world.checkCollision(min, max)) {
-                    low = mid;
-                } else {
-                    hight = mid;
-                }
-            }
+    if (moved.x != movement.x) {
+        velocity->position.x = 0.0f;
+    }
 
-            transform->position.y = hight;
+    if (moved.y != movement.y) {
+        if (movement.y < 0.0f) {
+            collider->isGrounded = true;
         }
 
         velocity->position.y = 0.0f;
-    } else {
-        transform->position.y = testPos.y;
-        if (transform->position.y < 0.0f) {
-            collider->isGrounded = true;
+    } else if (transform->position.y < 0.0f) {
+        collider->isGrounded = true;
+    }
+
+    if (moved.z != movement.z) {
+        velocity->position.z = 0.0f;
+    }
+
+    if (!collider->isGrounded) {
+        glm::vec3 probeMin = min;
+        probeMin.y = transform->position.y - collider->groundOffset * 2.0f;
+
+        glm::vec3 probeMax = max;
+        probeMax.y = probeMin.y + 0.1f;
+
+        for (const auto &block : blocks) {
+            if (overlaps(block, probeMin, probeMax)) {
+                collider->isGrounded = true;
+                break;
+            }
         }
     }
+}
 
-    testPos = transform->position;
-    testPos.z += movement.z;
+bool Physics::overlaps(
+    const glm::ivec3 &block,
+    const glm::vec3 &min,
+    const glm::vec3 &max
+)
+{
+    for (i32 axis = 0; axis < 3; axis++) {
+        if (
+            max[axis] <= block[axis] + COLLISION_EPSILON ||
+            min[axis] >= block[axis] + 1 - COLLISION_EPSILON
+        ) {
+            return false;
+        }
+    }
 
-    min = testPos + collider->offset - collider->size * 0.5f;
-    max = testPos + collider->offset + collider->size * 0.5f;
+    return true;
+}
 
-    if (m_world.checkCollision(min, max)) {
-        velocity->position.z = 0.0f;
-        movement.z = 0.0f;
-    } else {
-        transform->position.z = testPos.z;
+f32 Physics::clipAxis(
+    const std::vector<glm::ivec3> &blocks,
+    const glm::vec3 &min,
+    const glm::vec3 &max,
+    i32 axis,
+    f32 move
+)
+{
+    if (move == 0.0f) {
+        return 0.0f;
     }
 
-    if (!collider->isGrounded) {
-        glm::vec3 groundCheck = transform->position;
-        groundCheck.y -= collider->groundOffset;
+    const i32 u = (axis + 1) % 3;
+    const i32 v = (axis + 2) % 3;
 
-        min = groundCheck + collider->offset - collider->size * 0.5f;
-        min.y = groundCheck.y - collider->groundOffset;
+    // the move shrinks to the first face the box would pass through
+    for (const auto &block : blocks) {
+        if (
+            max[u] <= block[u] + COLLISION_EPSILON ||
+            min[u] >= block[u] + 1 - COLLISION_EPSILON ||
+            max[v] <= block[v] + COLLISION_EPSILON ||
+            min[v] >= block[v] + 1 - COLLISION_EPSILON
+        ) {
+            continue;
+        }
 
-        max = groundCheck + collider->offset + collider->size * 0.5f;
-        max.y = min.y + 0.1f;
+        f32 low = static_cast<f32>(block[axis]);
+        f32 high = low + 1.0f;
 
-        collider->isGrounded = m_world.checkCollision(min, max);
+        if (move > 0.0f && max[axis] <= low + COLLISION_EPSILON) {
+            move = std::min(move, low - max[axis]);
+        } else if (move < 0.0f && min[axis] >= high - COLLISION_EPSILON) {
+            move = std::max(move, high - min[axis]);
+        }
     }
+
+    return move;
 }
 
 } // namespace sys
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "ecs/systems/system.hpp"
 #include "world/world.hpp"
+#include "spatial_hash.hpp"
 
 #include "ecs/components/physics/transform.hpp"
 #include "ecs/components/physics/velocity.hpp"
@@ -19,9 +20,40 @@ public:
 
     void tick(f32 dt) override;
 
+    // boxes of every solid collider as of the end of the last tick, for
+    // entity queries such as pickups or perception
+    const SpatialHash &getBroadphase() const { return m_broadphase; }
+
+    usize getContacts() const { return m_contacts; }
+    f32 getBroadphaseTime() const { return m_broadphaseTime; }
+
 private:
+    static constexpr usize ENTITIES_PER_TASK = 64;
+    static constexpr f32 COLLISION_EPSILON = 0.0001f;
+
     wld::World &m_world;
 
+    std::vector<EntityID> m_entities;
+
+    SpatialHash m_broadphase;
+    usize m_contacts = 0;
+    f32 m_broadphaseTime = 0.0f;
+
+    void buildBroadphase();
+
+    // pushes overlapping entities apart horizontally, half each
+    void separateEntities();
+
+    // moves the entity by push, stopping at the first solid block
+    void pushEntity(
+        cmp::Transform *transform,
+        const cmp::Collider *collider,
+        const glm::vec3 &push
+    );
+    std::vector<glm::ivec3> m_pushBlocks;
+
+    void tickEntity(EntityID entity, f32 dt);
+
     void resolveCollisions(
         cmp::Transform *transform,
         cmp::Velocity *velocity,
@@ -29,6 +61,22 @@ private:
         f32
     );
 
+    static bool overlaps(
+        const glm::ivec3 &block,
+        const glm::vec3 &min,
+        const glm::vec3 &max
+    );
+
+    // furthest distance along axis, up to move, before the box touches
+    // one of the blocks
+    static f32 clipAxis(
+        const std::vector<glm::ivec3> &blocks,
+        const glm::vec3 &min,
+        const glm::vec3 &max,
+        i32 axis,
+        f32 move
+    );
+
 };
 
-} // namespace sys
+} // namespace sys
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "spatial_hash.hpp"
+
+namespace sys
+{
+
+void SpatialHash::clear()
+{
+    m_items.clear();
+    m_refs.clear();
+    m_unsorted.clear();
+}
+
+void SpatialHash::insert(EntityID entity, const glm::vec3 &min, const glm::vec3 &max)
+{
+    Item item;
+    item.entity = entity;
+    item.min = min;
+    item.max = max;
+    item.cellMin = getCell(min);
+    item.cellMax = getCell(max);
+
+    u32 index = static_cast<u32>(m_items.size());
+    m_items.push_back(item);
+
+    for (i32 x = item.cellMin.x; x <= item.cellMax.x; x++) {
+        for (i32 y = item.cellMin.y; y <= item.cellMax.y; y++) {
+            for (i32 z = item.cellMin.z; z <= item.cellMax.z; z++) {
+                m_unsorted.push_back({{x, y, z}, index});
+            }
+        }
+    }
+}
+
+void SpatialHash::build()
+{
+    u32 buckets = MIN_BUCKETS;
+    while (buckets < m_unsorted.size() * 2) {
+        buckets <<= 1;
+    }
+
+    m_mask = buckets - 1;
+
+    m_bucketStarts.assign(buckets + 1, 0);
+
+    for (const auto &ref : m_unsorted) {
+        m_bucketStarts[hashCell(ref.cell) & m_mask]++;
+    }
+
+    for (u32 i = 1; i < buckets; i++) {
+        m_bucketStarts[i] += m_bucketStarts[i - 1];
+    }
+
+    m_bucketStarts[buckets] = static_cast<u32>(m_unsorted.size());
+    m_refs.resize(m_unsorted.size());
+
+    // every bucket holds its end here, filling it backwards moves that
+    // to its start
+    for (auto it = m_unsorted.rbegin(); it != m_unsorted.rend(); ++it) {
+        m_refs[--m_bucketStarts[hashCell(it->cell) & m_mask]] = *it;
+    }
+
+    m_unsorted.clear();
+}
+
+} // namespace sys
\ No newline at end of file
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "core/types.hpp"
+
+namespace sys
+{
+
+// uniform grid over entity boxes, hashed into a table rebuilt every tick
+// by counting sort; an entity is listed in every cell its box touches
+class SpatialHash
+{
+
+public:
+    static constexpr f32 CELL_SIZE = 4.0f;
+
+    void clear();
+    void insert(EntityID entity, const glm::vec3 &min, const glm::vec3 &max);
+
+    // sorts the inserted entities into their cells, call before querying
+    void build();
+
+    // call fn once for every entity whose box overlaps the query box or
+    // comes within radius of center
+    template<typename Fn>
+    void queryBox(const glm::vec3 &min, const glm::vec3 &max, Fn &&fn) const;
+
+    template<typename Fn>
+    void queryRadius(const glm::vec3 &center, f32 radius, Fn &&fn) const;
+
+    usize size() const { return m_items.size(); }
+
+private:
+    static constexpr u32 MIN_BUCKETS = 64;
+
+    struct Item
+    {
+        EntityID entity;
+        glm::vec3 min;
+        glm::vec3 max;
+        glm::ivec3 cellMin;
+        glm::ivec3 cellMax;
+    };
+
+    struct Ref
+    {
+        glm::ivec3 cell;
+        u32 item;
+    };
+
+    std::vector<Item> m_items;
+    std::vector<Ref> m_refs;
+    std::vector<Ref> m_unsorted;
+    std::vector<u32> m_bucketStarts;
+    u32 m_mask = 0;
+
+    static glm::ivec3 getCell(const glm::vec3 &pos) {
+        return glm::ivec3(glm::floor(pos / CELL_SIZE));
+    }
+
+    template<typename Fn>
+    void forEachItem(const glm::vec3 &min, const glm::vec3 &max, Fn &&fn) const;
+
+    static u32 hashCell(const glm::ivec3 &cell) {
+        return static_cast<u32>(cell.x) * 73856093u ^
+            static_cast<u32>(cell.y) * 19349663u ^
+            static_cast<u32>(cell.z) * 83492791u;
+    }
+};
+
+template<typename Fn>
+void SpatialHash::forEachItem(const glm::vec3 &min, const glm::vec3 &max, Fn &&fn) const
+{
+    if (m_items.empty()) {
+        return;
+    }
+
+    glm::ivec3 queryMin = getCell(min);
+    glm::ivec3 queryMax = getCell(max);
+
+    for (i32 x = queryMin.x; x <= queryMax.x; x++) {
+        for (i32 y = queryMin.y; y <= queryMax.y; y++) {
+            for (i32 z = queryMin.z; z <= queryMax.z; z++) {
+                glm::ivec3 cell(x, y, z);
+                u32 bucket = hashCell(cell) & m_mask;
+
+                for (u32 i = m_bucketStarts[bucket]; i < m_bucketStarts[bucket + 1]; i++) {
+                    const Ref &ref = m_refs[i];
+                    if (ref.cell != cell) {
+                        continue;
+                    }
+
+                    const Item &item = m_items[ref.item];
+
+                    // an entity spanning several cells is reported from
+                    // the first cell it shares with the query only
+                    if (glm::max(item.cellMin, queryMin) != cell) {
+                        continue;
+                    }
+
+                    if (
+                        item.min.x <= max.x && item.max.x >= min.x &&
+                        item.min.y <= max.y && item.max.y >= min.y &&
+                        item.min.z <= max.z && item.max.z >= min.z
+                    ) {
+                        fn(item);
+                    }
+                }
+            }
+        }
+    }
+}
+
+template<typename Fn>
+void SpatialHash::queryBox(const glm::vec3 &min, const glm::vec3 &max, Fn &&fn) const
+{
+    forEachItem(min, max, [&](const Item &item) {
+        fn(item.entity);
+    });
+}
+
+template<typename Fn>
+void SpatialHash::queryRadius(const glm::vec3 &center, f32 radius, Fn &&fn) const
+{
+    forEachItem(center - radius, center + radius, [&](const Item &item) {
+        glm::vec3 closest = glm::clamp(center, item.min, item.max);
+        glm::vec3 offset = closest - center;
+
+        if (glm::dot(offset, offset) <= radius * radius) {
+            fn(item.entity);
+        }
+    });
+}
+
+} // namespace sys
\ No newline at end of file
@@ -18,6 +18,15 @@ Player::Player(
     m_world(world),
     m_overlay(overlay)
 {
+    // input, camera, audio and block edits stay on the main thread
+    m_access.write<
+        cmp::Player,
+        cmp::Transform,
+        cmp::Velocity,
+        cmp::Collider,
+        wld::World
+    >();
+    m_access.setMainThread();
 }
 
 void Player::tick(f32 dt)
@@ -1,12 +1,97 @@
 #pragma once
 
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
 #include "core/types.hpp"
+#include "core/thread/thread_pool.hpp"
+#include "ecs/components/component.hpp"
+#include "ecs/component_pool.hpp"
+#include "ecs/type_id.hpp"
 
 namespace ecs
 {
 
 class ECS;
 
+// the components and shared resources a system touches, systems whose
+// access does not conflict may tick concurrently
+class Access
+{
+
+public:
+    struct PoolType
+    {
+        u32 type;
+        std::unique_ptr<ComponentPoolBase> (*create)();
+    };
+
+    template<typename... Types>
+    void read() { (addType<Types>(m_reads), ...); }
+
+    template<typename... Types>
+    void write() { (addType<Types>(m_writes), ...); }
+
+    // the component types among the reads and writes, whose pools have to
+    // exist before systems tick concurrently
+    const std::vector<PoolType> &getPoolTypes() const { return m_poolTypes; }
+
+    // for systems that poll input or talk to the audio device
+    void setMainThread() { m_mainThread = true; }
+    bool isMainThread() const { return m_mainThread; }
+
+    bool conflicts(const Access &other) const
+    {
+        return overlaps(m_writes, other.m_writes) ||
+            overlaps(m_writes, other.m_reads) ||
+            overlaps(m_reads, other.m_writes);
+    }
+
+private:
+    std::vector<u32> m_reads;
+    std::vector<u32> m_writes;
+    std::vector<PoolType> m_poolTypes;
+    bool m_mainThread = false;
+
+    template<typename T>
+    void addType(std::vector<u32> &types)
+    {
+        add(types, getTypeID<T>());
+
+        // shared resources such as the world have no pool
+        if constexpr (std::is_base_of_v<Component, T>) {
+            m_poolTypes.push_back({getTypeID<T>(), &createPool<T>});
+        }
+    }
+
+    template<typename T>
+    static std::unique_ptr<ComponentPoolBase> createPool()
+    {
+        return std::make_unique<ComponentPool<T>>();
+    }
+
+    static void add(std::vector<u32> &types, u32 type)
+    {
+        if (std::find(types.begin(), types.end(), type) == types.end()) {
+            types.push_back(type);
+        }
+    }
+
+    static bool overlaps(const std::vector<u32> &a, const std::vector<u32> &b)
+    {
+        for (u32 type : a) {
+            if (std::find(b.begin(), b.end(), type) != b.end()) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+};
+
 class System
 {
 
@@ -16,9 +101,30 @@ public:
 
     virtual void tick(f32 dt) = 0;
 
+    const Access &getAccess() const { return m_access; }
+    void setWorkers(core::ThreadPool *workers) { m_workers = workers; }
+
 protected:
     ECS *m_ecs;
+    Access m_access;
+
+    // splits [0, count) into chunks of at most grain items across the
+    // workers, the body must only touch what the system declared
+    void parallelFor(
+        usize count,
+        usize grain,
+        const std::function<void(usize, usize)> &body
+    )
+    {
+        if (m_workers) {
+            m_workers->parallelFor(count, grain, body);
+        } else if (count > 0) {
+            body(0, count);
+        }
+    }
 
+private:
+    core::ThreadPool *m_workers = nullptr;
 
 };
 
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <atomic>
+
+#include "core/types.hpp"
+
+namespace ecs
+{
+
+// dense ids for component and resource types, assigned on first use,
+// which may happen on any worker
+inline u32 nextTypeID()
+{
+    static std::atomic<u32> next = 0;
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+template<typename T>
+u32 getTypeID()
+{
+    static const u32 id = nextTypeID();
+    return id;
+}
+
+} // namespace ecs
\ No newline at end of file
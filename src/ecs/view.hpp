@@ -0,0 +1,103 @@
+#pragma once
+
+#include "component_pool.hpp"
+
+#include <tuple>
+
+namespace ecs
+{
+
+// entities owning every listed component, walked through the smallest
+// pool; adding or removing the viewed components while iterating is not
+// supported
+template<typename... Components>
+class View
+{
+
+public:
+    explicit View(ComponentPool<Components> &... pools)
+        : m_pools(&pools...)
+    {
+        m_lead = std::get<0>(m_pools);
+
+        std::apply([this](auto *... pool) {
+            ((m_lead = pool->size() < m_lead->size() ? pool : m_lead), ...);
+        }, m_pools);
+    }
+
+    class Iterator
+    {
+
+    public:
+        Iterator(const View *view, usize index)
+            : m_view(view), m_index(index)
+        {
+            skip();
+        }
+
+        EntityID operator*() const { return m_view->m_lead->getEntities()[m_index]; }
+
+        Iterator &operator++()
+        {
+            m_index++;
+            skip();
+            return *this;
+        }
+
+        bool operator==(const Iterator &other) const { return m_index == other.m_index; }
+        bool operator!=(const Iterator &other) const { return m_index != other.m_index; }
+
+    private:
+        const View *m_view;
+        usize m_index;
+
+        void skip()
+        {
+            const auto &entities = m_view->m_lead->getEntities();
+            while (m_index < entities.size() && !m_view->containsAll(entities[m_index])) {
+                m_index++;
+            }
+        }
+    };
+
+    Iterator begin() const { return Iterator(this, 0); }
+    Iterator end() const { return Iterator(this, m_lead->size()); }
+
+    bool empty() const { return begin() == end(); }
+
+    template<typename T>
+    T *get(EntityID id) const
+    {
+        return std::get<ComponentPool<T> *>(m_pools)->get(id);
+    }
+
+    // calls func(EntityID, Components &...) for every match
+    template<typename Func>
+    void each(Func &&func) const
+    {
+        if constexpr (sizeof...(Components) == 1) {
+            auto *pool = std::get<0>(m_pools);
+            auto &components = pool->getComponents();
+            const auto &entities = pool->getEntities();
+
+            for (usize i = 0; i < entities.size(); i++) {
+                func(entities[i], components[i]);
+            }
+        } else {
+            for (EntityID id : *this) {
+                func(id, *get<Components>(id)...);
+            }
+        }
+    }
+
+private:
+    std::tuple<ComponentPool<Components> *...> m_pools;
+    const ComponentPoolBase *m_lead;
+
+    bool containsAll(EntityID id) const
+    {
+        return (std::get<ComponentPool<Components> *>(m_pools)->contains(id) && ...);
+    }
+};
+
+} // namespace ecs
\ No newline at end of file
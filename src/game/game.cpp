@@ -12,9 +12,16 @@ Game::Game() :
 
 void Game::init()
 {
+    auto start = std::chrono::steady_clock::now();
+
     m_window.init(1600, 900, "Minecraft Clone");
     
     m_device.init(m_window, "Minecraft Clone", {0, 1, 0});
+
+    u32 hardwareThreads = std::max(std::thread::hardware_concurrency(), 2u);
+    m_workers.init(std::min(hardwareThreads - 1, MAX_WORKER_THREADS));
+    m_device.createSecondaryPools(m_workers.getThreadCount() + 1);
+
     m_gpuData.init(m_device);
     m_textureCache.init(m_device);
 
@@ -29,6 +36,7 @@ void Game::init()
     sfx::SoundManager::get().init();
 
     m_world.init(m_device, m_textureCache);
+    m_world.setWorkers(&m_workers);
     m_sky.init(m_device);
     m_outline.init(m_device, m_world);
     m_clouds.init(m_device);
@@ -46,7 +54,9 @@ void Game::init()
     m_gui.initGameElements();
     m_gui.initPauseElements();
 
-    EntityID playerEntity = m_ecs.creatEntity();
+    m_playerEntity = m_ecs.creatEntity();
+    EntityID playerEntity = m_playerEntity;
+
     auto transform = m_ecs.addComponent<cmp::Transform>(playerEntity);
     transform->position = glm::vec3(0.0f, 80.0f, 0.0f);
 
@@ -60,11 +70,30 @@ void Game::init()
     playerCollider->groundOffset = 0.01f;
     playerCollider->isGhost = false;
 
+    m_scheduler.init(m_ecs, m_workers);
+    m_scheduler.add(m_playerSystem);
+    m_scheduler.add(m_physicsSystem);
+
+    std::chrono::duration<f32, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    char startup[64];
+    snprintf(
+        startup,
+        sizeof(startup),
+        "Startup took %.1f ms (%s pipeline cache)",
+        elapsed.count(),
+        m_device.getPipelineCache().isWarm() ? "warm" : "cold"
+    );
+
+    core::Logger::info(startup);
+
     m_running = true;
 }
 
 void Game::destroy()
 {
+    m_workers.destroy();
     m_device.waitIdle();
 
     m_gui.destroy();
@@ -140,9 +169,16 @@ void Game::run()
 
         f32 alpha = static_cast<f32>(accumulator / MS_PER_TICK);
 
+        // the loop time includes the vsync wait, so the governor is fed
+        // only the time spent updating and recording
+        f64 cpuStart = m_window.getCurrentTime();
+
         update(alpha);
-        
-        render();
+
+        f64 cpuTime = m_window.getCurrentTime() - cpuStart;
+        cpuTime += render();
+
+        m_world.reportFrameTime(static_cast<f32>(cpuTime));
     }
 }
 
@@ -205,39 +241,143 @@ void Game::tick(f32 dt)
         return;
     }
 
-    m_world.update(m_camera.getPos(), dt);
+    glm::vec3 playerVelocity(0.0f);
+    if (auto *velocity = m_ecs.getComponent<cmp::Velocity>(m_playerEntity)) {
+        playerVelocity = velocity->position;
+    }
+
+    m_world.update(m_camera.getPos(), playerVelocity, m_camera.getFront(), dt);
+    m_world.tickBlocks();
     m_clouds.update(dt);
 
-    m_playerSystem.tick(dt);
-    m_physicsSystem.tick(dt);
+    m_scheduler.tick(dt);
 }
 
-void Game::render()
+f64 Game::render()
 {
     auto cmd = m_device.beginFrame();
     if (!cmd) {
-        return;
+        return 0.0;
     }
 
-    m_display.begin(cmd);
-
-    m_sky.render(cmd);
-    m_world.render(m_camera, cmd);
-    m_outline.render(cmd, m_camera);
-    m_clouds.render(cmd, m_camera);
-    m_overlay.render(cmd);
-
+    f64 recordStart = m_window.getCurrentTime();
+
+    m_gpuData.beginFrame(cmd);
+
+    m_world.prepareRender(m_camera);
+
+    // early passes fill the depth buffer the occlusion cull reads, late
+    // passes draw whatever the cull found visible
+    std::vector<std::function<void(VkCommandBuffer)>> earlyPasses = {
+        [&](VkCommandBuffer pass) { m_sky.render(pass); },
+        [&](VkCommandBuffer pass) { m_world.renderOpaque(pass); },
+    };
+
+    std::vector<std::function<void(VkCommandBuffer)>> latePasses = {
+        [&](VkCommandBuffer pass) { m_world.renderOpaqueLate(pass); },
+        [&](VkCommandBuffer pass) { m_world.renderCutout(pass); },
+        [&](VkCommandBuffer pass) { m_world.renderTransparent(pass); },
+        [&](VkCommandBuffer pass) { m_outline.render(pass, m_camera); },
+        [&](VkCommandBuffer pass) { m_clouds.render(pass, m_camera); },
+        [&](VkCommandBuffer pass) { m_overlay.render(pass); },
+    };
+
+    std::vector<std::function<void(VkCommandBuffer)>> guiPasses = {
+        [&](VkCommandBuffer pass) { m_gui.render(pass); },
+    };
+
+    std::vector<VkCommandBuffer> earlyBuffers;
+    std::vector<VkCommandBuffer> lateBuffers;
+    std::vector<VkCommandBuffer> guiBuffers;
+
+    recordPasses(
+        earlyBuffers,
+        earlyPasses,
+        m_display.getColorFormat(),
+        m_display.getDepthFormat()
+    );
+    recordPasses(
+        lateBuffers,
+        latePasses,
+        m_display.getColorFormat(),
+        m_display.getDepthFormat()
+    );
+    recordPasses(
+        guiBuffers,
+        guiPasses,
+        m_device.getSwapchain().getFormat(),
+        m_device.getDepthFormat()
+    );
+
+    m_workers.wait();
+
+    m_display.begin(cmd, VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT);
+    vkCmdExecuteCommands(
+        cmd,
+        static_cast<u32>(earlyBuffers.size()),
+        earlyBuffers.data()
+    );
+    m_display.pause(cmd);
+
+    m_world.cull(cmd, m_display.getDepthImage());
+
+    m_display.resume(cmd, VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT);
+    vkCmdExecuteCommands(
+        cmd,
+        static_cast<u32>(lateBuffers.size()),
+        lateBuffers.data()
+    );
     m_display.end(cmd);
 
     m_device.beginRenderClear(cmd);
     m_display.draw(cmd);
     m_device.endRender(cmd);
 
-    m_device.beginRenderLoad(cmd);
-    m_gui.render(cmd);
+    m_device.beginRenderLoad(
+        cmd,
+        VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT
+    );
+    vkCmdExecuteCommands(
+        cmd,
+        static_cast<u32>(guiBuffers.size()),
+        guiBuffers.data()
+    );
     m_device.endRender(cmd);
 
+    f64 recordTime = m_window.getCurrentTime() - recordStart;
+
     m_device.endFrame(cmd);
+
+    return recordTime;
+}
+
+void Game::recordPasses(
+    std::vector<VkCommandBuffer> &buffers,
+    const std::vector<std::function<void(VkCommandBuffer)>> &passes,
+    VkFormat colorFormat,
+    VkFormat depthFormat
+)
+{
+    VkExtent2D extent = m_device.getExtent();
+
+    // each pass gets its own secondary so they can be recorded on any
+    // thread and still execute in submission order
+    buffers.resize(passes.size());
+
+    for (usize i = 0; i < passes.size(); i++) {
+        m_workers.submit([&, i, colorFormat, depthFormat, extent] {
+            VkCommandBuffer pass = m_device.beginSecondary(
+                colorFormat,
+                depthFormat,
+                extent
+            );
+
+            passes[i](pass);
+
+            m_device.endSecondary(pass);
+            buffers[i] = pass;
+        });
+    }
 }
 
 void Game::updateGui()
@@ -245,6 +385,36 @@ void Game::updateGui()
     gui::GameStat gameStat;
     gameStat.fps = static_cast<u32>(m_fps);
     gameStat.updatedChunks = m_world.getUpdatedChunks();
+    gameStat.meshTime = m_world.getMeshTime();
+
+    const auto &governor = m_world.getGovernor();
+    gameStat.renderDistance = governor.getRenderDistance();
+    gameStat.tickBudget = governor.getTickBudget() * 1000.0f;
+    gameStat.frameTime = governor.getFrameTime() * 1000.0f;
+    gameStat.budgetUsage = governor.getBudgetUsage() * 100.0f;
+    gameStat.fillTime = m_world.getFillTime();
+    gameStat.missingChunks = static_cast<u32>(m_world.getMissingChunks());
+    gameStat.tickAllocations = static_cast<u32>(m_world.getTickAllocations());
+    gameStat.cpuKiBPerChunk = m_world.getCpuBytesPerChunk() / 1024.0f;
+    gameStat.gpuKiBPerChunk = m_world.getGpuBytesPerChunk() / 1024.0f;
+    gameStat.opaqueFragments = m_world.getOpaqueFragments() / 1000.0f;
+    gameStat.cutoutFragments = m_world.getCutoutFragments() / 1000.0f;
+    gameStat.transparentFragments = m_world.getTransparentFragments() / 1000.0f;
+    gameStat.visibleChunks = static_cast<u32>(m_world.getVisibleChunks());
+    gameStat.loadedChunks = static_cast<u32>(m_world.getLoadedMeshes());
+    gameStat.visibleSections = static_cast<u32>(m_world.getVisibleSections());
+    gameStat.dueBlockTicks = static_cast<u32>(m_world.getDueBlockTicks());
+    gameStat.scheduledBlockTicks = static_cast<u32>(m_world.getScheduledBlockTicks());
+    gameStat.parkedBlockTicks = static_cast<u32>(m_world.getParkedBlockTicks());
+    gameStat.blockTickTime = m_world.getBlockTickTime();
+    gameStat.randomTickSections = static_cast<u32>(m_world.getRandomTickSections());
+    gameStat.randomTicks = static_cast<u32>(m_world.getRandomTicks());
+    gameStat.flowingWater = static_cast<u32>(m_world.getFlowingWater());
+    gameStat.flowingWaterChunks = static_cast<u32>(m_world.getFlowingWaterChunks());
+    gameStat.broadphaseEntities = static_cast<u32>(m_physicsSystem.getBroadphase().size());
+    gameStat.broadphaseContacts = static_cast<u32>(m_physicsSystem.getContacts());
+    gameStat.broadphaseTime = m_physicsSystem.getBroadphaseTime();
+
     gameStat.state = m_state;
 
     m_gui.updateStat(gameStat);
@@ -2,6 +2,7 @@
 
 #include "core/window/window.hpp"
 #include "core/camera/camera.hpp"
+#include "core/thread/thread_pool.hpp"
 #include "graphics/device.hpp"
 #include "graphics/pipeline.hpp"
 #include "graphics/gpu_data.hpp"
@@ -18,6 +19,7 @@
 #include "game/game_state.hpp"
 
 #include "ecs/ecs.hpp"
+#include "ecs/scheduler.hpp"
 #include "ecs/components/physics/transform.hpp"
 #include "ecs/components/physics/velocity.hpp"
 #include "ecs/components/physics/collider.hpp"
@@ -40,14 +42,25 @@ public:
 
 private:
     static constexpr f64 MS_PER_TICK = 0.05;
+    static constexpr u32 MAX_WORKER_THREADS = 4;
 
     void handleInput();
     void update(f32 dt);
     void tick(f32 dt);
-    void render();
+    // returns the time spent recording, without acquire and present
+    f64 render();
+    void recordPasses(
+        std::vector<VkCommandBuffer> &buffers,
+        const std::vector<std::function<void(VkCommandBuffer)>> &passes,
+        VkFormat colorFormat,
+        VkFormat depthFormat
+    );
 
     core::Window m_window;
     core::Camera m_camera;
+    // shared by the tick scheduler and render pass recording, which
+    // never overlap
+    core::ThreadPool m_workers;
 
     gfx::Device m_device;
     gfx::GPUData m_gpuData;
@@ -64,10 +77,13 @@ private:
     gui::GUI m_gui;
 
     ecs::ECS m_ecs;
+    EntityID m_playerEntity = ENTITY_NULL;
 
     sys::Player m_playerSystem;
     sys::Physics m_physicsSystem;
 
+    ecs::Scheduler m_scheduler;
+
     bool m_running;
 
     f32 m_fps;
@@ -30,6 +30,22 @@ void Buffer::init(
     bufferInfo.usage = usage;
     bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
+    // written on the transfer queue, read on the graphics queue
+    const auto &indices = m_device->getQueueFamilyIndices();
+    std::array<u32, 2> families = {
+        indices.graphicsFamily.value(),
+        indices.transferFamily.value_or(0)
+    };
+
+    if (
+        (usage & VK_BUFFER_USAGE_TRANSFER_DST_BIT) &&
+        m_device->hasTransferQueue()
+    ) {
+        bufferInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        bufferInfo.queueFamilyIndexCount = static_cast<u32>(families.size());
+        bufferInfo.pQueueFamilyIndices = families.data();
+    }
+
     VmaAllocationInfo allocationInfo{};
     
     VkResult res = vmaCreateBuffer(
@@ -59,6 +75,10 @@ void Buffer::destroy()
         m_buffer,
         m_allocation
     );
+
+    m_buffer = VK_NULL_HANDLE;
+    m_allocation = VK_NULL_HANDLE;
+    m_size = 0;
 }
 
 void *Buffer::map()
@@ -0,0 +1,153 @@
+#include "compute_pipeline.hpp"
+#include "device.hpp"
+
+namespace gfx
+{
+
+void ComputePipeline::init(
+    Device &device,
+    const fs::path &shader,
+    const std::vector<VkDescriptorSetLayoutBinding> &bindings,
+    u32 pushConstantSize
+)
+{
+    m_device = &device;
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = static_cast<u32>(bindings.size());
+    layoutInfo.pBindings = bindings.data();
+
+    VkResult res = vkCreateDescriptorSetLayout(
+        device.getDevice(),
+        &layoutInfo,
+        nullptr,
+        &m_setLayout
+    );
+
+    vk::check(res, "Failed to create compute descriptor set layout");
+
+    std::vector<VkDescriptorPoolSize> poolSizes;
+    for (const auto &binding : bindings) {
+        poolSizes.push_back({
+            binding.descriptorType,
+            binding.descriptorCount * MAX_SETS
+        });
+    }
+
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets = MAX_SETS;
+    poolInfo.poolSizeCount = static_cast<u32>(poolSizes.size());
+    poolInfo.pPoolSizes = poolSizes.data();
+
+    res = vkCreateDescriptorPool(
+        device.getDevice(),
+        &poolInfo,
+        nullptr,
+        &m_descriptorPool
+    );
+
+    vk::check(res, "Failed to create compute descriptor pool");
+
+    VkPushConstantRange pushConstantRange{};
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    pushConstantRange.offset = 0;
+    pushConstantRange.size = pushConstantSize;
+
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+    pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount = 1;
+    pipelineLayoutInfo.pSetLayouts = &m_setLayout;
+    pipelineLayoutInfo.pushConstantRangeCount = pushConstantSize > 0 ? 1 : 0;
+    pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+    res = vkCreatePipelineLayout(
+        device.getDevice(),
+        &pipelineLayoutInfo,
+        nullptr,
+        &m_pipelineLayout
+    );
+
+    vk::check(res, "Failed to create compute pipeline layout");
+
+    VkPipelineShaderStageCreateInfo stageInfo{};
+    stageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stageInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    stageInfo.module = device.getPipelineCache().getShaderModule(shader);
+    stageInfo.pName = "main";
+
+    VkComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage = stageInfo;
+    pipelineInfo.layout = m_pipelineLayout;
+
+    res = vkCreateComputePipelines(
+        device.getDevice(),
+        device.getPipelineCache().getCache(),
+        1,
+        &pipelineInfo,
+        nullptr,
+        &m_pipeline
+    );
+
+    vk::check(res, "Failed to create compute pipeline");
+}
+
+void ComputePipeline::destroy()
+{
+    VkDevice device = m_device->getDevice();
+
+    vkDestroyPipeline(device, m_pipeline, nullptr);
+    vkDestroyPipelineLayout(device, m_pipelineLayout, nullptr);
+    vkDestroyDescriptorPool(device, m_descriptorPool, nullptr);
+    vkDestroyDescriptorSetLayout(device, m_setLayout, nullptr);
+}
+
+VkDescriptorSet ComputePipeline::allocateSet()
+{
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = m_descriptorPool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &m_setLayout;
+
+    VkDescriptorSet set;
+    VkResult res = vkAllocateDescriptorSets(
+        m_device->getDevice(),
+        &allocInfo,
+        &set
+    );
+
+    vk::check(res, "Failed to allocate compute descriptor set");
+
+    return set;
+}
+
+void ComputePipeline::resetSets()
+{
+    vkResetDescriptorPool(m_device->getDevice(), m_descriptorPool, 0);
+}
+
+void ComputePipeline::bind(VkCommandBuffer cmd, VkDescriptorSet set)
+{
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline);
+
+    vkCmdBindDescriptorSets(
+        cmd,
+        VK_PIPELINE_BIND_POINT_COMPUTE,
+        m_pipelineLayout,
+        0,
+        1,
+        &set,
+        0,
+        nullptr
+    );
+}
+
+void ComputePipeline::dispatch(VkCommandBuffer cmd, u32 x, u32 y, u32 z)
+{
+    vkCmdDispatch(cmd, x, y, z);
+}
+
+} // namespace gfx
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <vector>
+#include <filesystem>
+
+#include "core/types.hpp"
+
+namespace fs = std::filesystem;
+
+namespace gfx
+{
+
+class Device;
+
+// compute passes that need storage images use their own descriptor sets
+// instead of the bindless set, which only exposes sampled textures
+class ComputePipeline
+{
+
+public:
+    ComputePipeline() = default;
+    ~ComputePipeline() = default;
+
+    void init(
+        Device &device,
+        const fs::path &shader,
+        const std::vector<VkDescriptorSetLayoutBinding> &bindings,
+        u32 pushConstantSize
+    );
+
+    void destroy();
+
+    VkDescriptorSet allocateSet();
+    void resetSets();
+
+    void bind(VkCommandBuffer cmd, VkDescriptorSet set);
+    void dispatch(VkCommandBuffer cmd, u32 x, u32 y = 1, u32 z = 1);
+
+    template<typename T>
+    void push(VkCommandBuffer cmd, const T &data);
+
+public:
+    VkDescriptorSetLayout getSetLayout() const { return m_setLayout; }
+
+private:
+    Device *m_device = nullptr;
+
+    VkPipeline m_pipeline = VK_NULL_HANDLE;
+    VkPipelineLayout m_pipelineLayout = VK_NULL_HANDLE;
+    VkDescriptorSetLayout m_setLayout = VK_NULL_HANDLE;
+    VkDescriptorPool m_descriptorPool = VK_NULL_HANDLE;
+
+    static constexpr u32 MAX_SETS = 32;
+};
+
+template<typename T>
+void ComputePipeline::push(VkCommandBuffer cmd, const T &data)
+{
+    vkCmdPushConstants(
+        cmd,
+        m_pipelineLayout,
+        VK_SHADER_STAGE_COMPUTE_BIT,
+        0,
+        sizeof(T),
+        &data
+    );
+}
+
+} // namespace gfx
\ No newline at end of file
@@ -22,6 +22,9 @@ void Device::init(
     m_queueFamilyIndices = vk::findQueueFamilies(m_physicalDevice, m_surface);
     m_graphicsQueue = vk::getGraphicsQueue(m_device, m_queueFamilyIndices);
     m_presentQueue = vk::getPresentQueue(m_device, m_queueFamilyIndices);
+    m_transferQueue = vk::getTransferQueue(m_device, m_queueFamilyIndices);
+
+    m_pipelineCache.init(*this, PIPELINE_CACHE_PATH);
 
     u32 width = m_window->getWidth();
     u32 height = m_window->getHeight();
@@ -51,21 +54,38 @@ void Device::init(
     );
 
     m_bindlessManager.init(*this);
+
+    m_uploadManager.init(
+        *this,
+        m_queueFamilyIndices.transferFamily.value_or(
+            m_queueFamilyIndices.graphicsFamily.value()
+        ),
+        m_transferQueue
+    );
 }
 
 void Device::destroy()
 {
+    waitIdle();
+    destroyRetired(true);
+
+    m_uploadManager.destroy();
     m_bindlessManager.destroy();
     vkDestroySampler(m_device, m_defaultSampler, nullptr);
 
     m_depthBuffer.destroy();
     vmaDestroyAllocator(m_allocator);
 
-    for (auto frame : m_frames) {
+    for (auto &frame : m_frames) {
+        for (auto &secondary : frame.secondaryPools) {
+            vkDestroyCommandPool(m_device, secondary.pool, nullptr);
+        }
+
         vkDestroyCommandPool(m_device, frame.commandPool, nullptr);
     }
 
     m_swapchain.destroy();
+    m_pipelineCache.destroy();
 
     vkDestroyDevice(m_device, nullptr);
     vkDestroySurfaceKHR(m_instance, m_surface, nullptr);
@@ -77,6 +97,7 @@ void Device::destroy()
 VkCommandBuffer Device::beginFrame()
 {
     m_swapchain.beginFrame(m_currentFrame);
+    destroyRetired(false);
 
     auto [imageIndex, image] = m_swapchain.acquireNextImage(m_currentFrame);
     m_imageIndex = imageIndex;
@@ -88,6 +109,7 @@ VkCommandBuffer Device::beginFrame()
 
     auto &frame = m_frames[m_currentFrame];
     vkResetCommandBuffer(frame.commandBuffer, 0);
+    resetSecondaryPools(frame);
 
     VkCommandBufferBeginInfo beginInfo{};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
@@ -130,7 +152,13 @@ void Device::endFrame(VkCommandBuffer cmd)
     VkResult res = vkEndCommandBuffer(cmd);
     vk::check(res, "Failed to end command buffer");
 
-    m_swapchain.submit(m_currentFrame, cmd, m_graphicsQueue);
+    m_swapchain.submit(
+        m_currentFrame,
+        cmd,
+        m_graphicsQueue,
+        m_uploadManager.getSemaphore(),
+        m_uploadManager.getCompletedValue()
+    );
     m_swapchain.present(m_currentFrame, m_presentQueue);
 
     if (m_swapchain.isOutOfDate()) {
@@ -139,19 +167,24 @@ void Device::endFrame(VkCommandBuffer cmd)
     }
 
     m_currentFrame = (m_currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+    m_frameCount++;
 }
 
-void Device::beginRenderClear(VkCommandBuffer cmd)
+void Device::beginRenderClear(VkCommandBuffer cmd, VkRenderingFlags flags)
 {
-    beginRender(cmd, VK_ATTACHMENT_LOAD_OP_CLEAR);
+    beginRender(cmd, VK_ATTACHMENT_LOAD_OP_CLEAR, flags);
 }
 
-void Device::beginRenderLoad(VkCommandBuffer cmd)
+void Device::beginRenderLoad(VkCommandBuffer cmd, VkRenderingFlags flags)
 {
-    beginRender(cmd, VK_ATTACHMENT_LOAD_OP_LOAD);
+    beginRender(cmd, VK_ATTACHMENT_LOAD_OP_LOAD, flags);
 }
 
-void Device::beginRender(VkCommandBuffer cmd, VkAttachmentLoadOp loadOp)
+void Device::beginRender(
+    VkCommandBuffer cmd,
+    VkAttachmentLoadOp loadOp,
+    VkRenderingFlags flags
+)
 {
     VkExtent2D extent = m_swapchain.getExtent();
     VkClearColorValue clearColor = {{0.0f, 0.0f, 0.0f, 1.0f}};
@@ -218,6 +251,7 @@ void Device::beginRender(VkCommandBuffer cmd, VkAttachmentLoadOp loadOp)
 
     VkRenderingInfoKHR renderingInfo{};
     renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
+    renderingInfo.flags = flags;
     renderingInfo.renderArea.offset = {0, 0};
     renderingInfo.renderArea.extent = extent;
     renderingInfo.layerCount = 1;
@@ -227,6 +261,10 @@ void Device::beginRender(VkCommandBuffer cmd, VkAttachmentLoadOp loadOp)
 
     vkCmdBeginRendering(cmd, &renderingInfo);
 
+    if (flags & VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT) {
+        return;
+    }
+
     VkViewport viewport{};
     viewport.x = 0.0f;
     viewport.y = 0.0f;
@@ -248,6 +286,85 @@ void Device::endRender(VkCommandBuffer cmd)
     vkCmdEndRendering(cmd);
 }
 
+void Device::createSecondaryPools(u32 workerCount)
+{
+    for (auto &frame : m_frames) {
+        frame.secondaryPools.resize(workerCount);
+
+        for (auto &secondary : frame.secondaryPools) {
+            if (secondary.pool == VK_NULL_HANDLE) {
+                secondary.pool = vk::createCommandPool(
+                    m_device,
+                    m_queueFamilyIndices.graphicsFamily.value()
+                );
+            }
+        }
+    }
+}
+
+VkCommandBuffer Device::beginSecondary(
+    VkFormat colorFormat,
+    VkFormat depthFormat,
+    VkExtent2D extent
+)
+{
+    u32 worker = core::ThreadPool::getWorkerIndex();
+    auto &secondary = m_frames[m_currentFrame].secondaryPools.at(worker);
+
+    if (secondary.used == secondary.buffers.size()) {
+        secondary.buffers.push_back(vk::createCommandBuffer(
+            m_device,
+            secondary.pool,
+            VK_COMMAND_BUFFER_LEVEL_SECONDARY
+        ));
+    }
+
+    VkCommandBuffer cmd = secondary.buffers[secondary.used++];
+
+    VkCommandBufferInheritanceRenderingInfo renderingInfo{};
+    renderingInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO;
+    renderingInfo.colorAttachmentCount = 1;
+    renderingInfo.pColorAttachmentFormats = &colorFormat;
+    renderingInfo.depthAttachmentFormat = depthFormat;
+    renderingInfo.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    VkCommandBufferInheritanceInfo inheritanceInfo{};
+    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritanceInfo.pNext = &renderingInfo;
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+                      VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+    VkResult res = vkBeginCommandBuffer(cmd, &beginInfo);
+    vk::check(res, "Failed to begin secondary command buffer");
+
+    VkViewport viewport{};
+    viewport.x = 0.0f;
+    viewport.y = 0.0f;
+    viewport.width = static_cast<float>(extent.width);
+    viewport.height = static_cast<float>(extent.height);
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+
+    VkRect2D scissor{};
+    scissor.offset = {0, 0};
+    scissor.extent = extent;
+
+    vkCmdSetViewport(cmd, 0, 1, &viewport);
+    vkCmdSetScissor(cmd, 0, 1, &scissor);
+
+    return cmd;
+}
+
+void Device::endSecondary(VkCommandBuffer cmd)
+{
+    VkResult res = vkEndCommandBuffer(cmd);
+    vk::check(res, "Failed to end secondary command buffer");
+}
+
 VkCommandBuffer Device::beginSingleTimeCommands()
 {
     auto &frame = m_frames[m_currentFrame];
@@ -411,6 +528,17 @@ Image Device::createImageFromData(
     return image;
 }
 
+void Device::retire(const Buffer &buffer)
+{
+    if (buffer.isValid()) {
+        m_retired.push_back({
+            buffer,
+            m_frameCount,
+            m_uploadManager.getRecordedValue()
+        });
+    }
+}
+
 void Device::waitIdle()
 {
     vkDeviceWaitIdle(m_device);
@@ -419,6 +547,7 @@ void Device::waitIdle()
 void Device::recreateSwapchain()
 {
     waitIdle();
+    destroyRetired(true);
 
     u32 width = m_window->getWidth();
     u32 height = m_window->getHeight();
@@ -432,4 +561,36 @@ void Device::recreateSwapchain()
     m_depthBuffer.resize(width, height);
 }
 
+void Device::destroyRetired(bool all)
+{
+    // frames up to m_frameCount - MAX_FRAMES_IN_FLIGHT have finished once
+    // this frame's fence has been waited on, and a buffer may still be the
+    // destination of a copy on the transfer queue until its upload lands
+    usize kept = 0;
+
+    for (auto &retired : m_retired) {
+        if (
+            !all && (
+                !isReleased(retired.frame) ||
+                !m_uploadManager.isComplete(retired.upload)
+            )
+        ) {
+            m_retired[kept++] = retired;
+            continue;
+        }
+
+        retired.buffer.destroy();
+    }
+
+    m_retired.resize(kept);
+}
+
+void Device::resetSecondaryPools(FrameData &frame)
+{
+    for (auto &secondary : frame.secondaryPools) {
+        vkResetCommandPool(m_device, secondary.pool, 0);
+        secondary.used = 0;
+    }
+}
+
 } // namespace gfx
\ No newline at end of file
@@ -2,12 +2,15 @@
 
 #include "core/types.hpp"
 #include "core/window/window.hpp"
+#include "core/thread/thread_pool.hpp"
 #include "utils/init.hpp"
 #include "global.hpp"
 #include "swapchain.hpp"
 #include "buffer.hpp"
 #include "depth_buffer.hpp"
 #include "bindless_manager.hpp"
+#include "upload_manager.hpp"
+#include "pipeline_cache.hpp"
 
 namespace gfx
 {
@@ -31,12 +34,27 @@ public:
     void endFrame(VkCommandBuffer cmd);
 
 
-    void beginRenderClear(VkCommandBuffer cmd);
-    void beginRenderLoad(VkCommandBuffer cmd);
+    void beginRenderClear(VkCommandBuffer cmd, VkRenderingFlags flags = 0);
+    void beginRenderLoad(VkCommandBuffer cmd, VkRenderingFlags flags = 0);
 
-    void beginRender(VkCommandBuffer cmd, VkAttachmentLoadOp loadOp);
+    void beginRender(
+        VkCommandBuffer cmd,
+        VkAttachmentLoadOp loadOp,
+        VkRenderingFlags flags = 0
+    );
     void endRender(VkCommandBuffer cmd);
 
+    void createSecondaryPools(u32 workerCount);
+
+    // records into the calling worker's pool for the current frame, to be
+    // executed inside a rendering begun with the secondary contents flag
+    VkCommandBuffer beginSecondary(
+        VkFormat colorFormat,
+        VkFormat depthFormat,
+        VkExtent2D extent
+    );
+    void endSecondary(VkCommandBuffer cmd);
+
     VkCommandBuffer beginSingleTimeCommands();
     void endSingleTimeCommands(VkCommandBuffer commandBuffer);
 
@@ -116,6 +134,15 @@ public:
         m_bindlessManager.update();
     }
 
+    void retire(const Buffer &buffer);
+
+    // a buffer dropped while the given frame was recorded is no longer
+    // read by the GPU once this returns true
+    bool isReleased(u64 frame) const {
+        return frame + MAX_FRAMES_IN_FLIGHT <= m_frameCount + 1;
+    }
+    u64 getFrameCount() const { return m_frameCount; }
+
     void waitIdle();
 
 public:
@@ -136,18 +163,45 @@ public:
     VkSampler getDefaultSampler() const { return m_defaultSampler; }
 
     BindlessManager &getBindlessManager() { return m_bindlessManager; }
+    UploadManager &getUploadManager() { return m_uploadManager; }
+    PipelineCache &getPipelineCache() { return m_pipelineCache; }
 
     VkQueue getGraphicsQueue() const { return m_graphicsQueue; }
     VkQueue getPresentQueue() const { return m_presentQueue; }
+    VkQueue getTransferQueue() const { return m_transferQueue; }
+
+    const vk::QueueFamilyIndices &getQueueFamilyIndices() const {
+        return m_queueFamilyIndices;
+    }
+
+    bool hasTransferQueue() const {
+        return m_queueFamilyIndices.transferFamily.has_value();
+    }
 
     u32 getCurrentFrame() const { return m_currentFrame; }
     u32 getImageIndex() const { return m_imageIndex; }
 
 private:
+    struct SecondaryPool
+    {
+        VkCommandPool pool = VK_NULL_HANDLE;
+        std::vector<VkCommandBuffer> buffers;
+        u32 used = 0;
+    };
+
     struct FrameData
     {
         VkCommandPool commandPool = VK_NULL_HANDLE;
         VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+
+        std::vector<SecondaryPool> secondaryPools;
+    };
+
+    struct RetiredBuffer
+    {
+        Buffer buffer;
+        u64 frame;
+        u64 upload;
     };
 
 private:
@@ -165,19 +219,27 @@ private:
     VkSampler m_defaultSampler = VK_NULL_HANDLE;
 
     BindlessManager m_bindlessManager;
+    UploadManager m_uploadManager;
+    PipelineCache m_pipelineCache;
 
     vk::QueueFamilyIndices m_queueFamilyIndices;
     VkQueue m_graphicsQueue = VK_NULL_HANDLE;
     VkQueue m_presentQueue = VK_NULL_HANDLE;
+    VkQueue m_transferQueue = VK_NULL_HANDLE;
 
     VkDebugUtilsMessengerEXT m_debugMessenger = VK_NULL_HANDLE;
 
     std::array<FrameData, MAX_FRAMES_IN_FLIGHT> m_frames;
     u32 m_currentFrame = 0;
     u32 m_imageIndex = 0;
+    u64 m_frameCount = 0;
+
+    std::vector<RetiredBuffer> m_retired;
 
 private:
     void recreateSwapchain();
+    void destroyRetired(bool all);
+    void resetSecondaryPools(FrameData &frame);
 
 };
 
@@ -39,12 +39,12 @@ void Display::resize(u32 width, u32 height)
     m_framebuffer.resize(width, height);
 }
 
-void Display::begin(VkCommandBuffer cmd)
+void Display::begin(VkCommandBuffer cmd, VkRenderingFlags flags)
 {
     VkExtent2D extent = m_device->getExtent();
     resize(extent.width, extent.height);
 
-    m_framebuffer.begin(cmd);
+    m_framebuffer.begin(cmd, flags);
 }
 
 void Display::end(VkCommandBuffer cmd)
@@ -52,6 +52,16 @@ void Display::end(VkCommandBuffer cmd)
     m_framebuffer.end(cmd);
 }
 
+void Display::pause(VkCommandBuffer cmd)
+{
+    m_framebuffer.pause(cmd);
+}
+
+void Display::resume(VkCommandBuffer cmd, VkRenderingFlags flags)
+{
+    m_framebuffer.resume(cmd, flags);
+}
+
 void Display::draw(VkCommandBuffer cmd)
 {
     m_pipeline.bind(cmd);
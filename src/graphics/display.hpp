@@ -20,14 +20,22 @@ public:
 
     void resize(u32 width, u32 height);
 
-    void begin(VkCommandBuffer cmd);
+    void begin(VkCommandBuffer cmd, VkRenderingFlags flags = 0);
     void end(VkCommandBuffer cmd);
 
+    void pause(VkCommandBuffer cmd);
+    void resume(VkCommandBuffer cmd, VkRenderingFlags flags = 0);
+
     void draw(VkCommandBuffer cmd);
 
 public:
     void setColor(const glm::vec4 &color) { m_pc.color = color; }
 
+    VkFormat getColorFormat() const { return m_framebuffer.getColorFormat(); }
+    VkFormat getDepthFormat() const { return m_framebuffer.getDepthFormat(); }
+
+    const Image &getDepthImage() { return m_framebuffer.getDepthImage(); }
+
 private:
     Device *m_device = nullptr;
 
@@ -30,7 +30,7 @@ void Framebuffer::init(
         m_depthImage = m_device->createImage(
             m_width, m_height,
             m_depthFormat,
-            VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
+            VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
             VK_IMAGE_ASPECT_DEPTH_BIT
         );
     }
@@ -72,7 +72,7 @@ void Framebuffer::resize(u32 width, u32 height)
         m_depthImage = m_device->createImage(
             m_width, m_height,
             m_depthFormat,
-            VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
+            VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
             VK_IMAGE_ASPECT_DEPTH_BIT
         );
     }
@@ -80,7 +80,7 @@ void Framebuffer::resize(u32 width, u32 height)
     m_textureID = m_device->addTexture(m_colorImage);
 }
 
-void Framebuffer::begin(VkCommandBuffer cmd)
+void Framebuffer::begin(VkCommandBuffer cmd, VkRenderingFlags flags)
 {
     transitionColorLayout(
         cmd,
@@ -88,16 +88,51 @@ void Framebuffer::begin(VkCommandBuffer cmd)
         VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
     );
 
+    if (m_withDepth) {
+        transitionDepthLayout(cmd);
+    }
+
+    beginRendering(cmd, flags, VK_ATTACHMENT_LOAD_OP_CLEAR);
+}
+
+void Framebuffer::end(VkCommandBuffer cmd)
+{
+    vkCmdEndRendering(cmd);
+
+    transitionColorLayout(
+        cmd,
+        VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+    );
+}
+
+void Framebuffer::pause(VkCommandBuffer cmd)
+{
+    vkCmdEndRendering(cmd);
+}
+
+void Framebuffer::resume(VkCommandBuffer cmd, VkRenderingFlags flags)
+{
+    beginRendering(cmd, flags, VK_ATTACHMENT_LOAD_OP_LOAD);
+}
+
+void Framebuffer::beginRendering(
+    VkCommandBuffer cmd,
+    VkRenderingFlags flags,
+    VkAttachmentLoadOp loadOp
+)
+{
     VkRenderingAttachmentInfoKHR colorAttachmentInfo{};
     colorAttachmentInfo.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
     colorAttachmentInfo.imageView = m_colorImage.getImageView();
     colorAttachmentInfo.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-    colorAttachmentInfo.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    colorAttachmentInfo.loadOp = loadOp;
     colorAttachmentInfo.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
     colorAttachmentInfo.clearValue.color = {{0.0f, 0.0f, 0.0f, 1.0f}};
     
     VkRenderingInfoKHR renderingInfo{};
     renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
+    renderingInfo.flags = flags;
     renderingInfo.renderArea = {{0, 0}, {m_width, m_height}};
     renderingInfo.layerCount = 1;
     renderingInfo.colorAttachmentCount = 1;
@@ -108,7 +143,7 @@ void Framebuffer::begin(VkCommandBuffer cmd)
         depthAttachmentInfo.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
         depthAttachmentInfo.imageView = m_depthImage.getImageView();
         depthAttachmentInfo.imageLayout = VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL;
-        depthAttachmentInfo.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        depthAttachmentInfo.loadOp = loadOp;
         depthAttachmentInfo.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
         depthAttachmentInfo.clearValue.depthStencil = {1.0f, 0};
         
@@ -119,6 +154,10 @@ void Framebuffer::begin(VkCommandBuffer cmd)
 
     vkCmdBeginRendering(cmd, &renderingInfo);
 
+    if (flags & VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT) {
+        return;
+    }
+
     VkViewport viewport{};
     viewport.x = 0.0f;
     viewport.y = 0.0f;
@@ -135,15 +174,33 @@ void Framebuffer::begin(VkCommandBuffer cmd)
     vkCmdSetScissor(cmd, 0, 1, &scissor);
 }
 
-void Framebuffer::end(VkCommandBuffer cmd)
+void Framebuffer::transitionDepthLayout(VkCommandBuffer cmd)
 {
-    vkCmdEndRendering(cmd);
+    VkImageMemoryBarrier2 barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+    barrier.image = m_depthImage.getImage();
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+    barrier.subresourceRange.baseMipLevel = 0;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = 1;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout = VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL;
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT |
+                           VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT;
+    barrier.srcAccessMask = VK_ACCESS_2_SHADER_READ_BIT |
+                            VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    barrier.dstStageMask = VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT |
+                           VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT;
+    barrier.dstAccessMask = VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                            VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
 
-    transitionColorLayout(
-        cmd,
-        VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-    );
+    VkDependencyInfoKHR dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.imageMemoryBarrierCount = 1;
+    dependencyInfo.pImageMemoryBarriers = &barrier;
+
+    vkCmdPipelineBarrier2(cmd, &dependencyInfo);
 }
 
 void Framebuffer::transitionColorLayout(
@@ -25,9 +25,12 @@ public:
     void destroy();
     void resize(u32 width, u32 height);
 
-    void begin(VkCommandBuffer cmd);
+    void begin(VkCommandBuffer cmd, VkRenderingFlags flags = 0);
     void end(VkCommandBuffer cmd);
 
+    void pause(VkCommandBuffer cmd);
+    void resume(VkCommandBuffer cmd, VkRenderingFlags flags = 0);
+
 public:
     u32 getWidth() const { return m_width; }
     u32 getHeight() const { return m_height; }
@@ -55,6 +58,13 @@ private:
     u32 m_textureID = U32_MAX;
 
 private:
+    void beginRendering(
+        VkCommandBuffer cmd,
+        VkRenderingFlags flags,
+        VkAttachmentLoadOp loadOp
+    );
+
+    void transitionDepthLayout(VkCommandBuffer cmd);
     void transitionColorLayout(
         VkCommandBuffer cmd,
         VkImageLayout oldLayout,
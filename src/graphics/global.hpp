@@ -6,5 +6,6 @@ namespace gfx
 {
 
 static constexpr u32 MAX_FRAMES_IN_FLIGHT = 2;
+static constexpr const char *PIPELINE_CACHE_PATH = "pipeline_cache.bin";
 
 } // namespace gfx
\ No newline at end of file
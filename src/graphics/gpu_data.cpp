@@ -13,54 +13,122 @@ void GPUData::init(Device &device)
 void GPUData::destroy()
 {
     m_device->waitIdle();
+    m_ring.destroy();
     m_timeBuffer.destroy();
     m_cameraBuffer.destroy();
 }
 
 void GPUData::updateCamera(const core::Camera &camera)
 {
-    auto data = static_cast<CameraUBO *>(m_cameraBuffer.map());
+    m_camera.view = camera.getView();
+    m_camera.proj = camera.getProj();
+    m_camera.ortho = camera.getOrtho();
+    m_camera.position = camera.getPos();
+}
 
-    data->view = camera.getView();
-    data->proj = camera.getProj();
-    data->ortho = camera.getOrtho();
-    data->position = camera.getPos();
+void GPUData::updateTime(f32 time, f32 deltaTime)
+{
+    m_time.time = time;
+    m_time.deltaTime = deltaTime;
+}
 
-    m_cameraBuffer.unmap();
+void GPUData::update()
+{
+    m_device->update();
 }
 
-void GPUData::updateTime(f32 time, f32 deltaTime)
+void GPUData::beginFrame(VkCommandBuffer cmd)
 {
-    auto data = static_cast<TimeUBO *>(m_timeBuffer.map());
+    // the fence for this slot has been waited on, so its slice is free
+    m_ringHead = m_device->getCurrentFrame() * FRAME_RING_SIZE;
+    m_ringEnd = m_ringHead + FRAME_RING_SIZE;
+
+    Allocation camera = allocate(m_camera);
+    Allocation time = allocate(m_time);
+
+    std::array<VkBufferMemoryBarrier2, 2> barriers{};
+
+    for (auto &barrier : barriers) {
+        barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+        barrier.srcStageMask = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT |
+            VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
+        barrier.srcAccessMask = VK_ACCESS_2_UNIFORM_READ_BIT;
+        barrier.dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+        barrier.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.offset = 0;
+        barrier.size = VK_WHOLE_SIZE;
+    }
 
-    data->time = time;
-    data->deltaTime = deltaTime;
+    barriers[0].buffer = m_cameraBuffer.getBuffer();
+    barriers[1].buffer = m_timeBuffer.getBuffer();
 
-    m_timeBuffer.unmap();
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.bufferMemoryBarrierCount = static_cast<u32>(barriers.size());
+    dependencyInfo.pBufferMemoryBarriers = barriers.data();
+
+    vkCmdPipelineBarrier2(cmd, &dependencyInfo);
+
+    VkBufferCopy cameraRegion{camera.offset, 0, sizeof(CameraUBO)};
+    vkCmdCopyBuffer(cmd, camera.buffer, m_cameraBuffer.getBuffer(), 1, &cameraRegion);
+
+    VkBufferCopy timeRegion{time.offset, 0, sizeof(TimeUBO)};
+    vkCmdCopyBuffer(cmd, time.buffer, m_timeBuffer.getBuffer(), 1, &timeRegion);
+
+    for (auto &barrier : barriers) {
+        barrier.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+        barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        barrier.dstStageMask = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT |
+            VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
+        barrier.dstAccessMask = VK_ACCESS_2_UNIFORM_READ_BIT;
+    }
+
+    vkCmdPipelineBarrier2(cmd, &dependencyInfo);
 }
 
-void GPUData::update()
+GPUData::Allocation GPUData::allocate(VkDeviceSize size)
 {
-    m_device->update();
+    VkDeviceSize offset = (m_ringHead + m_alignment - 1) & ~(m_alignment - 1);
+
+    if (offset + size > m_ringEnd) {
+        throw std::runtime_error("Frame ring is out of space!");
+    }
+
+    m_ringHead = offset + size;
+
+    return {m_ringData + offset, m_ring.getBuffer(), offset};
 }
 
 void GPUData::createBuffers()
 {
-    m_cameraBuffer = m_device->createBuffer(
-        sizeof(CameraUBO),
-        VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(m_device->getPhysicalDevice(), &properties);
+
+    m_alignment = std::max<VkDeviceSize>(
+        properties.limits.minUniformBufferOffsetAlignment,
+        16
+    );
+
+    m_ring = m_device->createBuffer(
+        FRAME_RING_SIZE * MAX_FRAMES_IN_FLIGHT,
+        VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
         VMA_MEMORY_USAGE_CPU_TO_GPU
     );
 
-    CameraUBO defaultData;
-    defaultData.view = glm::mat4(1.0f);
-    defaultData.proj = glm::mat4(1.0f);
-    defaultData.ortho = glm::mat4(1.0f);
-    defaultData.position = glm::vec3(0.0f);
+    m_ringData = static_cast<u8 *>(m_ring.map());
 
-    auto data = static_cast<CameraUBO *>(m_cameraBuffer.map());
-    *data = defaultData;
-    m_cameraBuffer.unmap();
+    m_camera.view = glm::mat4(1.0f);
+    m_camera.proj = glm::mat4(1.0f);
+    m_camera.ortho = glm::mat4(1.0f);
+    m_camera.position = glm::vec3(0.0f);
+
+    m_cameraBuffer = m_device->createBuffer(
+        sizeof(CameraUBO),
+        VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VMA_MEMORY_USAGE_GPU_ONLY
+    );
 
     u32 cameraID = m_device->addUBO(m_cameraBuffer);
     if (cameraID != CAMERA_UBO) {
@@ -69,20 +137,15 @@ void GPUData::createBuffers()
 
     m_device->update();
 
+    m_time.time = 1.0f;
+    m_time.deltaTime = 1.0f;
+
     m_timeBuffer = m_device->createBuffer(
         sizeof(TimeUBO),
-        VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-        VMA_MEMORY_USAGE_CPU_TO_GPU
+        VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VMA_MEMORY_USAGE_GPU_ONLY
     );
 
-    TimeUBO timeData;
-    timeData.time = 1.0f;
-    timeData.deltaTime = 1.0f;
-
-    auto timePtr = static_cast<TimeUBO *>(m_timeBuffer.map());
-    *timePtr = timeData;
-    m_timeBuffer.unmap();
-
     u32 timeID = m_device->addUBO(m_timeBuffer);
     if (timeID != TIME_UBO) {
         throw std::runtime_error("Failed to add time UBO to bindless manager!");
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+
 #include "core/types.hpp"
 #include "graphics/buffer.hpp"
 #include "graphics/device.hpp"
@@ -37,13 +39,47 @@ public:
 
     void update();
 
+    void beginFrame(VkCommandBuffer cmd);
+
+    static constexpr VkDeviceSize FRAME_RING_SIZE = 64 * 1024;
+
 private:
+    struct Allocation
+    {
+        void *data = nullptr;
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceSize offset = 0;
+    };
+
     Device *m_device = nullptr;
 
     Buffer m_cameraBuffer;
     Buffer m_timeBuffer;
 
+    CameraUBO m_camera;
+    TimeUBO m_time;
+
+    Buffer m_ring;
+    u8 *m_ringData = nullptr;
+
+    VkDeviceSize m_ringHead = 0;
+    VkDeviceSize m_ringEnd = 0;
+    VkDeviceSize m_alignment = 0;
+
     void createBuffers();
+
+    Allocation allocate(VkDeviceSize size);
+
+    template<typename T>
+    Allocation allocate(const T &data);
 };
 
+template<typename T>
+GPUData::Allocation GPUData::allocate(const T &data)
+{
+    Allocation allocation = allocate(sizeof(T));
+    memcpy(allocation.data, &data, sizeof(T));
+    return allocation;
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,271 @@
+#include "hiz_buffer.hpp"
+#include "device.hpp"
+
+namespace gfx
+{
+
+namespace
+{
+
+VkImageMemoryBarrier2 imageBarrier(
+    VkImage image,
+    VkImageAspectFlags aspect,
+    VkImageLayout oldLayout,
+    VkImageLayout newLayout,
+    VkPipelineStageFlags2 srcStage,
+    VkAccessFlags2 srcAccess,
+    VkPipelineStageFlags2 dstStage,
+    VkAccessFlags2 dstAccess
+)
+{
+    VkImageMemoryBarrier2 barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+    barrier.srcStageMask = srcStage;
+    barrier.srcAccessMask = srcAccess;
+    barrier.dstStageMask = dstStage;
+    barrier.dstAccessMask = dstAccess;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange.aspectMask = aspect;
+    barrier.subresourceRange.baseMipLevel = 0;
+    barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = 1;
+
+    return barrier;
+}
+
+} // namespace
+
+void HiZBuffer::init(Device &device)
+{
+    m_device = &device;
+
+    std::vector<VkDescriptorSetLayoutBinding> bindings = {
+        {
+            0,
+            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+            1,
+            VK_SHADER_STAGE_COMPUTE_BIT,
+            nullptr
+        },
+        {
+            1,
+            VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+            1,
+            VK_SHADER_STAGE_COMPUTE_BIT,
+            nullptr
+        }
+    };
+
+    m_pipeline.init(device, "hiz.comp.spv", bindings, sizeof(PushConstants));
+
+    m_sampler = device.createSampler(
+        VK_FILTER_NEAREST,
+        VK_FILTER_NEAREST,
+        VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE
+    );
+}
+
+void HiZBuffer::destroy()
+{
+    release();
+
+    vkDestroySampler(m_device->getDevice(), m_sampler, nullptr);
+    m_pipeline.destroy();
+}
+
+void HiZBuffer::build(VkCommandBuffer cmd, const Image &depth)
+{
+    if (depth.getImageView() != m_source) {
+        create(depth);
+    }
+
+    std::array<VkImageMemoryBarrier2, 2> barriers = {
+        imageBarrier(
+            depth.getImage(),
+            VK_IMAGE_ASPECT_DEPTH_BIT,
+            VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+            VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+            VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+            VK_ACCESS_2_SHADER_SAMPLED_READ_BIT
+        ),
+        // last frame's culling read the pyramid, its contents are rebuilt
+        imageBarrier(
+            m_image.getImage(),
+            VK_IMAGE_ASPECT_COLOR_BIT,
+            VK_IMAGE_LAYOUT_UNDEFINED,
+            VK_IMAGE_LAYOUT_GENERAL,
+            VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+            0,
+            VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+            VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT
+        )
+    };
+
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.imageMemoryBarrierCount = static_cast<u32>(barriers.size());
+    dependencyInfo.pImageMemoryBarriers = barriers.data();
+
+    vkCmdPipelineBarrier2(cmd, &dependencyInfo);
+
+    VkMemoryBarrier2 levelBarrier{};
+    levelBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    levelBarrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    levelBarrier.srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    levelBarrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    levelBarrier.dstAccessMask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT;
+
+    VkDependencyInfo levelDependency{};
+    levelDependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    levelDependency.memoryBarrierCount = 1;
+    levelDependency.pMemoryBarriers = &levelBarrier;
+
+    glm::ivec2 srcSize(depth.getWidth(), depth.getHeight());
+
+    for (u32 level = 0; level < m_levels; level++) {
+        glm::ivec2 dstSize(
+            std::max(m_width >> level, 1u),
+            std::max(m_height >> level, 1u)
+        );
+
+        PushConstants pc = {
+            .srcSize = srcSize,
+            .dstSize = dstSize
+        };
+
+        m_pipeline.bind(cmd, m_sets[level]);
+        m_pipeline.push(cmd, pc);
+        m_pipeline.dispatch(
+            cmd,
+            (dstSize.x + GROUP_SIZE - 1) / GROUP_SIZE,
+            (dstSize.y + GROUP_SIZE - 1) / GROUP_SIZE
+        );
+
+        vkCmdPipelineBarrier2(cmd, &levelDependency);
+
+        srcSize = dstSize;
+    }
+
+    VkImageMemoryBarrier2 depthBarrier = imageBarrier(
+        depth.getImage(),
+        VK_IMAGE_ASPECT_DEPTH_BIT,
+        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL,
+        VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+        0,
+        VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT |
+            VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+        VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+            VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT
+    );
+
+    dependencyInfo.imageMemoryBarrierCount = 1;
+    dependencyInfo.pImageMemoryBarriers = &depthBarrier;
+
+    vkCmdPipelineBarrier2(cmd, &dependencyInfo);
+}
+
+void HiZBuffer::create(const Image &depth)
+{
+    m_device->waitIdle();
+
+    release();
+
+    m_source = depth.getImageView();
+
+    m_width = std::max(depth.getWidth() / 2, 1u);
+    m_height = std::max(depth.getHeight() / 2, 1u);
+    m_levels = static_cast<u32>(
+        std::floor(std::log2(std::max(m_width, m_height)))
+    ) + 1;
+
+    m_image = m_device->createImage(
+        m_width,
+        m_height,
+        VK_FORMAT_R32_SFLOAT,
+        VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+        VK_IMAGE_ASPECT_COLOR_BIT,
+        m_levels
+    );
+
+    for (u32 level = 0; level < m_levels; level++) {
+        m_levelViews.push_back(m_image.createView(
+            VK_FORMAT_R32_SFLOAT,
+            VK_IMAGE_ASPECT_COLOR_BIT,
+            level,
+            1
+        ));
+    }
+
+    for (u32 level = 0; level < m_levels; level++) {
+        VkDescriptorImageInfo srcInfo{};
+        srcInfo.sampler = m_sampler;
+
+        if (level == 0) {
+            srcInfo.imageView = m_source;
+            srcInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        } else {
+            srcInfo.imageView = m_levelViews[level - 1];
+            srcInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+        }
+
+        VkDescriptorImageInfo dstInfo{};
+        dstInfo.imageView = m_levelViews[level];
+        dstInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+        VkDescriptorSet set = m_pipeline.allocateSet();
+
+        std::array<VkWriteDescriptorSet, 2> writes{};
+
+        writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[0].dstSet = set;
+        writes[0].dstBinding = 0;
+        writes[0].descriptorCount = 1;
+        writes[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writes[0].pImageInfo = &srcInfo;
+
+        writes[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[1].dstSet = set;
+        writes[1].dstBinding = 1;
+        writes[1].descriptorCount = 1;
+        writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        writes[1].pImageInfo = &dstInfo;
+
+        vkUpdateDescriptorSets(
+            m_device->getDevice(),
+            static_cast<u32>(writes.size()),
+            writes.data(),
+            0,
+            nullptr
+        );
+
+        m_sets.push_back(set);
+    }
+}
+
+void HiZBuffer::release()
+{
+    for (auto view : m_levelViews) {
+        vkDestroyImageView(m_device->getDevice(), view, nullptr);
+    }
+
+    if (m_image.isValid()) {
+        m_image.destroy();
+        m_image = Image{};
+    }
+
+    m_pipeline.resetSets();
+
+    m_levelViews.clear();
+    m_sets.clear();
+    m_source = VK_NULL_HANDLE;
+}
+
+} // namespace gfx
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <array>
+#include <cmath>
+#include <algorithm>
+
+#include "core/types.hpp"
+#include "image.hpp"
+#include "compute_pipeline.hpp"
+
+namespace gfx
+{
+
+class Device;
+
+// max-depth pyramid of a depth attachment, rebuilt on demand so chunks can
+// be tested against what has already been drawn this frame
+class HiZBuffer
+{
+
+public:
+    HiZBuffer() = default;
+    ~HiZBuffer() = default;
+
+    void init(Device &device);
+    void destroy();
+
+    // expects the depth image in DEPTH_ATTACHMENT_OPTIMAL and returns it
+    // there, the pyramid is left in GENERAL for compute reads
+    void build(VkCommandBuffer cmd, const Image &depth);
+
+public:
+    VkImageView getImageView() const { return m_image.getImageView(); }
+    VkSampler getSampler() const { return m_sampler; }
+
+    u32 getWidth() const { return m_width; }
+    u32 getHeight() const { return m_height; }
+    u32 getLevels() const { return m_levels; }
+
+private:
+    Device *m_device = nullptr;
+
+    ComputePipeline m_pipeline;
+    VkSampler m_sampler = VK_NULL_HANDLE;
+
+    Image m_image;
+    std::vector<VkImageView> m_levelViews;
+    std::vector<VkDescriptorSet> m_sets;
+
+    VkImageView m_source = VK_NULL_HANDLE;
+
+    u32 m_width = 0;
+    u32 m_height = 0;
+    u32 m_levels = 0;
+
+    static constexpr u32 GROUP_SIZE = 8;
+
+    struct PushConstants
+    {
+        alignas(8) glm::ivec2 srcSize;
+        alignas(8) glm::ivec2 dstSize;
+    };
+
+    void create(const Image &depth);
+    void release();
+};
+
+} // namespace gfx
\ No newline at end of file
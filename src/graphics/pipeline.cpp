@@ -13,8 +13,7 @@ Pipeline::Builder &Pipeline::Builder::setShader(
     VkShaderStageFlagBits stage
 )
 {
-    auto code = readFile(path);
-    auto shaderModule = createShaderModule(code);
+    auto shaderModule = m_device.getPipelineCache().getShaderModule(path);
 
     VkPipelineShaderStageCreateInfo shaderStageInfo{};
     shaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -96,11 +95,40 @@ Pipeline::Builder &Pipeline::Builder::setLineWidth(f32 width)
     return *this;
 }
 
+Pipeline::Builder &Pipeline::Builder::setSpecialization(
+    u32 constantID,
+    u32 value
+)
+{
+    VkSpecializationMapEntry entry{};
+    entry.constantID = constantID;
+    entry.offset = static_cast<u32>(m_specializationData.size() * sizeof(u32));
+    entry.size = sizeof(u32);
+
+    m_specializationEntries.push_back(entry);
+    m_specializationData.push_back(value);
+
+    return *this;
+}
+
 Pipeline Pipeline::Builder::build()
 {
     VkPipeline pipeline;
     VkPipelineLayout pipelineLayout;
 
+    if (!m_specializationEntries.empty()) {
+        m_specializationInfo.mapEntryCount =
+            static_cast<u32>(m_specializationEntries.size());
+        m_specializationInfo.pMapEntries = m_specializationEntries.data();
+        m_specializationInfo.dataSize = m_specializationData.size() * sizeof(u32);
+        m_specializationInfo.pData = m_specializationData.data();
+
+        // constants a stage does not declare are ignored by that stage
+        for (auto &shaderStage : m_shaderStages) {
+            shaderStage.pSpecializationInfo = &m_specializationInfo;
+        }
+    }
+
     VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
     vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
     vertexInputInfo.vertexBindingDescriptionCount = m_vertexInputSet ? 1 : 0;
@@ -223,7 +251,7 @@ Pipeline Pipeline::Builder::build()
 
     res = vkCreateGraphicsPipelines(
         m_device.getDevice(),
-        VK_NULL_HANDLE,
+        m_device.getPipelineCache().getCache(),
         1,
         &pipelineInfo,
         nullptr,
@@ -232,10 +260,6 @@ Pipeline Pipeline::Builder::build()
 
     vk::check(res, "failed to create graphics pipeline!");
 
-    for (auto& shaderStage : m_shaderStages) {
-        vkDestroyShaderModule(m_device.getDevice(), shaderStage.module, nullptr);
-    }
-
     Pipeline pipelineObj;
 
     pipelineObj.m_device = &m_device;
@@ -247,47 +271,6 @@ Pipeline Pipeline::Builder::build()
     return pipelineObj;
 }
 
-std::vector<char> Pipeline::Builder::readFile(const fs::path &filename)
-{
-    fs::path filepath = fs::path("assets/shaders") / filename;
-
-    std::ifstream file(filepath, std::ios::ate | std::ios::binary);
-    if (!file.is_open()) {
-        throw std::runtime_error("failed to open file: " + filepath.string());
-    }
-
-    usize fileSize = (size_t)file.tellg();
-    std::vector<char> buffer(fileSize);
-    
-    file.seekg(0);
-    file.read(buffer.data(), fileSize);
-    file.close();
-
-    return buffer;
-} 
-
-VkShaderModule Pipeline::Builder::createShaderModule(
-    const std::vector<char> &code
-)
-{
-    VkShaderModuleCreateInfo createInfo{};
-    createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-    createInfo.codeSize = code.size();
-    createInfo.pCode = reinterpret_cast<const uint32_t *>(code.data());
-
-    VkShaderModule shaderModule;
-    VkResult res = vkCreateShaderModule(
-        m_device.getDevice(),
-        &createInfo,
-        nullptr,
-        &shaderModule
-    );
-
-    vk::check(res, "failed to create shader module!");
-
-    return shaderModule;
-}
-
 void Pipeline::destroy()
 {
     vkDestroyPipeline(m_device->getDevice(), m_pipeline, nullptr);
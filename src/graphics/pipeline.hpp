@@ -47,6 +47,7 @@ public:
         Builder &setBlending(bool enable);
         Builder &setTopology(VkPrimitiveTopology topology);
         Builder &setLineWidth(f32 width);
+        Builder &setSpecialization(u32 constantID, u32 value);
 
         Pipeline build();
 
@@ -76,8 +77,9 @@ public:
         VkPrimitiveTopology m_topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
         f32 m_lineWidth = 1.0f;
 
-        std::vector<char> readFile(const fs::path &filename);
-        VkShaderModule createShaderModule(const std::vector<char> &code);
+        std::vector<VkSpecializationMapEntry> m_specializationEntries;
+        std::vector<u32> m_specializationData;
+        VkSpecializationInfo m_specializationInfo = {};
 
     };
 
@@ -0,0 +1,160 @@
+#include "pipeline_cache.hpp"
+#include "device.hpp"
+
+#include <fstream>
+#include <cstring>
+
+namespace gfx
+{
+
+static std::vector<char> readBinary(const fs::path &filepath)
+{
+    std::ifstream file(filepath, std::ios::ate | std::ios::binary);
+    if (!file.is_open()) {
+        return {};
+    }
+
+    usize fileSize = static_cast<usize>(file.tellg());
+    std::vector<char> buffer(fileSize);
+
+    file.seekg(0);
+    file.read(buffer.data(), fileSize);
+
+    return buffer;
+}
+
+void PipelineCache::init(Device &device, const fs::path &path)
+{
+    m_device = &device;
+    m_path = path;
+
+    std::vector<char> data = readBinary(m_path);
+
+    m_warm = isCompatible(data);
+    if (!m_warm) {
+        data.clear();
+    }
+
+    VkPipelineCacheCreateInfo cacheInfo{};
+    cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    cacheInfo.initialDataSize = data.size();
+    cacheInfo.pInitialData = data.empty() ? nullptr : data.data();
+
+    VkResult res = vkCreatePipelineCache(
+        device.getDevice(),
+        &cacheInfo,
+        nullptr,
+        &m_cache
+    );
+
+    vk::check(res, "Failed to create pipeline cache");
+}
+
+void PipelineCache::destroy()
+{
+    save();
+
+    for (auto &[name, shaderModule] : m_shaderModules) {
+        vkDestroyShaderModule(m_device->getDevice(), shaderModule, nullptr);
+    }
+
+    m_shaderModules.clear();
+
+    vkDestroyPipelineCache(m_device->getDevice(), m_cache, nullptr);
+    m_cache = VK_NULL_HANDLE;
+}
+
+VkShaderModule PipelineCache::getShaderModule(const fs::path &filename)
+{
+    if (auto it = m_shaderModules.find(filename.string()); it != m_shaderModules.end()) {
+        return it->second;
+    }
+
+    fs::path filepath = fs::path("assets/shaders") / filename;
+
+    std::vector<char> code = readBinary(filepath);
+    if (code.empty()) {
+        throw std::runtime_error("failed to open file: " + filepath.string());
+    }
+
+    VkShaderModuleCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    createInfo.codeSize = code.size();
+    createInfo.pCode = reinterpret_cast<const uint32_t *>(code.data());
+
+    VkShaderModule shaderModule;
+    VkResult res = vkCreateShaderModule(
+        m_device->getDevice(),
+        &createInfo,
+        nullptr,
+        &shaderModule
+    );
+
+    vk::check(res, "failed to create shader module!");
+
+    m_shaderModules.emplace(filename.string(), shaderModule);
+
+    return shaderModule;
+}
+
+bool PipelineCache::isCompatible(const std::vector<char> &data) const
+{
+    VkPipelineCacheHeaderVersionOne header{};
+    if (data.size() < sizeof(header)) {
+        return false;
+    }
+
+    memcpy(&header, data.data(), sizeof(header));
+
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(m_device->getPhysicalDevice(), &properties);
+
+    // a cache from another driver or GPU is rejected instead of handed over
+    return header.headerSize >= sizeof(header) &&
+        header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+        header.vendorID == properties.vendorID &&
+        header.deviceID == properties.deviceID &&
+        memcmp(
+            header.pipelineCacheUUID,
+            properties.pipelineCacheUUID,
+            VK_UUID_SIZE
+        ) == 0;
+}
+
+void PipelineCache::save()
+{
+    usize size = 0;
+    VkResult res = vkGetPipelineCacheData(
+        m_device->getDevice(),
+        m_cache,
+        &size,
+        nullptr
+    );
+
+    if (res != VK_SUCCESS || size == 0) {
+        return;
+    }
+
+    std::vector<char> data(size);
+    res = vkGetPipelineCacheData(
+        m_device->getDevice(),
+        m_cache,
+        &size,
+        data.data()
+    );
+
+    if (res != VK_SUCCESS) {
+        core::Logger::warn("Failed to read pipeline cache data");
+        return;
+    }
+
+    std::ofstream file(m_path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        core::Logger::warn("Failed to write " + m_path.string());
+        return;
+    }
+
+    file.write(data.data(), static_cast<std::streamsize>(size));
+}
+
+} // namespace gfx
\ No newline at end of file
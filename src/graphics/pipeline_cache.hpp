@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <unordered_map>
+
+#include "core/types.hpp"
+
+namespace fs = std::filesystem;
+
+namespace gfx
+{
+
+class Device;
+
+class PipelineCache
+{
+
+public:
+    PipelineCache() = default;
+    ~PipelineCache() = default;
+
+    void init(Device &device, const fs::path &path);
+    void destroy();
+
+    VkShaderModule getShaderModule(const fs::path &filename);
+
+public:
+    VkPipelineCache getCache() const { return m_cache; }
+    bool isWarm() const { return m_warm; }
+
+private:
+    Device *m_device = nullptr;
+
+    fs::path m_path;
+    VkPipelineCache m_cache = VK_NULL_HANDLE;
+    bool m_warm = false;
+
+    std::unordered_map<std::string, VkShaderModule> m_shaderModules;
+
+    bool isCompatible(const std::vector<char> &data) const;
+    void save();
+};
+
+} // namespace gfx
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "query_pool.hpp"
+#include "device.hpp"
+
+namespace gfx
+{
+
+void QueryPool::init(
+    Device &device,
+    u32 queryCount,
+    VkQueryPipelineStatisticFlags statistics
+)
+{
+    m_device = &device;
+    m_queryCount = queryCount;
+
+    VkQueryPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    poolInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+    poolInfo.queryCount = queryCount * MAX_FRAMES_IN_FLIGHT;
+    poolInfo.pipelineStatistics = statistics;
+
+    VkResult res = vkCreateQueryPool(
+        device.getDevice(),
+        &poolInfo,
+        nullptr,
+        &m_pool
+    );
+
+    vk::check(res, "Failed to create query pool");
+
+    vkResetQueryPool(device.getDevice(), m_pool, 0, poolInfo.queryCount);
+
+    m_results.assign(queryCount, 0);
+    m_written.assign(MAX_FRAMES_IN_FLIGHT, false);
+}
+
+void QueryPool::destroy()
+{
+    vkDestroyQueryPool(m_device->getDevice(), m_pool, nullptr);
+    m_pool = VK_NULL_HANDLE;
+}
+
+void QueryPool::beginFrame()
+{
+    m_frame = m_device->getCurrentFrame();
+
+    const u32 first = m_frame * m_queryCount;
+
+    // this frame's fence has been waited on, so its queries are available
+    if (m_written[m_frame]) {
+        vkGetQueryPoolResults(
+            m_device->getDevice(),
+            m_pool,
+            first,
+            m_queryCount,
+            m_results.size() * sizeof(u64),
+            m_results.data(),
+            sizeof(u64),
+            VK_QUERY_RESULT_64_BIT
+        );
+    }
+
+    vkResetQueryPool(m_device->getDevice(), m_pool, first, m_queryCount);
+    m_written[m_frame] = true;
+}
+
+void QueryPool::begin(VkCommandBuffer cmd, u32 query)
+{
+    vkCmdBeginQuery(cmd, m_pool, m_frame * m_queryCount + query, 0);
+}
+
+void QueryPool::end(VkCommandBuffer cmd, u32 query)
+{
+    vkCmdEndQuery(cmd, m_pool, m_frame * m_queryCount + query);
+}
+
+} // namespace gfx
\ No newline at end of file
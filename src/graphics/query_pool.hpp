@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <vector>
+
+#include "core/types.hpp"
+
+namespace gfx
+{
+
+class Device;
+
+class QueryPool
+{
+
+public:
+    QueryPool() = default;
+    ~QueryPool() = default;
+
+    void init(
+        Device &device,
+        u32 queryCount,
+        VkQueryPipelineStatisticFlags statistics
+    );
+
+    void destroy();
+
+    void beginFrame();
+
+    void begin(VkCommandBuffer cmd, u32 query);
+    void end(VkCommandBuffer cmd, u32 query);
+
+    u64 getResult(u32 query) const { return m_results[query]; }
+
+private:
+    Device *m_device = nullptr;
+
+    VkQueryPool m_pool = VK_NULL_HANDLE;
+    u32 m_queryCount = 0;
+    u32 m_frame = 0;
+
+    std::vector<u64> m_results;
+    std::vector<bool> m_written;
+};
+
+} // namespace gfx
\ No newline at end of file
@@ -143,7 +143,9 @@ std::pair<u32, VkImage> Swapchain::acquireNextImage(u32 currentFrame)
 void Swapchain::submit(
     u32 currentFrame,
     VkCommandBuffer commandBuffer,
-    VkQueue graphicsQueue
+    VkQueue graphicsQueue,
+    VkSemaphore uploadSemaphore,
+    u64 uploadValue
 )
 {
     if (m_outOfDate) {
@@ -155,12 +157,28 @@ void Swapchain::submit(
     VkSubmitInfo submitInfo{};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 
-    VkSemaphore waitSemaphores[] = {frame.imageSemaphore};
-    VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-    submitInfo.waitSemaphoreCount = 1;
+    VkSemaphore waitSemaphores[] = {frame.imageSemaphore, uploadSemaphore};
+    VkPipelineStageFlags waitStages[] = {
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        VK_PIPELINE_STAGE_VERTEX_INPUT_BIT
+    };
+    u64 waitValues[] = {0, uploadValue};
+
+    // the upload value has already been reached on the host, so this never
+    // stalls but makes the transfer writes visible to the graphics queue
+    VkTimelineSemaphoreSubmitInfo timelineInfo{};
+    timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timelineInfo.waitSemaphoreValueCount = 2;
+    timelineInfo.pWaitSemaphoreValues = waitValues;
+
+    submitInfo.waitSemaphoreCount = uploadSemaphore != VK_NULL_HANDLE ? 2 : 1;
     submitInfo.pWaitSemaphores = waitSemaphores;
     submitInfo.pWaitDstStageMask = waitStages;
 
+    if (uploadSemaphore != VK_NULL_HANDLE) {
+        submitInfo.pNext = &timelineInfo;
+    }
+
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &commandBuffer;
 
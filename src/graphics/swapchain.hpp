@@ -35,7 +35,9 @@ public:
     std::pair<u32, VkImage> acquireNextImage(u32 currentFrame);
     void submit(u32 currentFrame,
         VkCommandBuffer commandBuffer,
-        VkQueue graphicsQueue
+        VkQueue graphicsQueue,
+        VkSemaphore uploadSemaphore = VK_NULL_HANDLE,
+        u64 uploadValue = 0
     );
     void present(u32 currentFrame, VkQueue presentQueue);
 
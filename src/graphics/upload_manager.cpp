@@ -0,0 +1,255 @@
+#include "upload_manager.hpp"
+#include "device.hpp"
+
+namespace gfx
+{
+
+void UploadManager::init(Device &device, u32 queueFamily, VkQueue queue)
+{
+    m_device = &device;
+    m_queue = queue;
+
+    m_commandPool = vk::createCommandPool(
+        device.getDevice(),
+        queueFamily,
+        VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT
+    );
+
+    for (auto &batch : m_batches) {
+        batch.commandBuffer = vk::createCommandBuffer(
+            device.getDevice(),
+            m_commandPool
+        );
+    }
+
+    m_semaphore = vk::createTimelineSemaphore(device.getDevice());
+
+    m_staging = device.createBuffer(
+        STAGING_SIZE,
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        VMA_MEMORY_USAGE_CPU_ONLY
+    );
+
+    m_stagingData = static_cast<u8 *>(m_staging.map());
+}
+
+void UploadManager::destroy()
+{
+    if (m_recording) {
+        submit();
+    }
+
+    if (m_submittedValue > 0) {
+        VkSemaphoreWaitInfo waitInfo{};
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &m_semaphore;
+        waitInfo.pValues = &m_submittedValue;
+
+        vkWaitSemaphores(m_device->getDevice(), &waitInfo, U64_MAX);
+    }
+
+    m_staging.destroy();
+    m_stagingData = nullptr;
+
+    vkDestroySemaphore(m_device->getDevice(), m_semaphore, nullptr);
+    vkDestroyCommandPool(m_device->getDevice(), m_commandPool, nullptr);
+}
+
+Buffer UploadManager::uploadBuffer(
+    const void *data,
+    VkDeviceSize size,
+    VkBufferUsageFlags usage
+)
+{
+    Buffer buffer = m_device->createBuffer(
+        size,
+        usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VMA_MEMORY_USAGE_GPU_ONLY
+    );
+
+    uploadToBuffer(buffer, data, size);
+
+    return buffer;
+}
+
+void UploadManager::uploadToBuffer(
+    const Buffer &buffer,
+    const void *data,
+    VkDeviceSize size
+)
+{
+    if (size == 0) {
+        return;
+    }
+
+    VkDeviceSize offset = reserve(size);
+    memcpy(m_stagingData + offset, data, size);
+
+    vmaFlushAllocation(
+        m_device->getAllocator(),
+        m_staging.getAllocation(),
+        offset,
+        size
+    );
+
+    VkBufferCopy region{};
+    region.srcOffset = offset;
+    region.dstOffset = 0;
+    region.size = size;
+
+    vkCmdCopyBuffer(
+        begin(),
+        m_staging.getBuffer(),
+        buffer.getBuffer(),
+        1,
+        &region
+    );
+}
+
+u64 UploadManager::submit()
+{
+    if (!m_recording) {
+        return m_submittedValue;
+    }
+
+    auto &batch = m_batches[(m_firstBatch + m_batchCount) % MAX_BATCHES];
+
+    VkResult res = vkEndCommandBuffer(batch.commandBuffer);
+    vk::check(res, "Failed to end upload command buffer");
+
+    batch.value = ++m_submittedValue;
+    batch.bytes = m_recordedBytes;
+
+    VkTimelineSemaphoreSubmitInfo timelineInfo{};
+    timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timelineInfo.signalSemaphoreValueCount = 1;
+    timelineInfo.pSignalSemaphoreValues = &batch.value;
+
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.pNext = &timelineInfo;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &batch.commandBuffer;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores = &m_semaphore;
+
+    res = vkQueueSubmit(m_queue, 1, &submitInfo, VK_NULL_HANDLE);
+    vk::check(res, "Failed to submit upload command buffer");
+
+    m_batchCount++;
+    m_recording = false;
+    m_recordedBytes = 0;
+
+    return m_submittedValue;
+}
+
+bool UploadManager::isComplete(u64 value)
+{
+    if (value > m_completedValue) {
+        reclaim();
+    }
+
+    return value <= m_completedValue;
+}
+
+VkDeviceSize UploadManager::reserve(VkDeviceSize size)
+{
+    size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+    if (size > STAGING_SIZE) {
+        throw std::runtime_error("Upload is larger than the staging ring.");
+    }
+
+    // never split an upload across the end of the ring
+    bool wrap = m_head + size > STAGING_SIZE;
+    VkDeviceSize padding = wrap ? STAGING_SIZE - m_head : 0;
+
+    while (STAGING_SIZE - m_used < padding + size) {
+        waitOldest();
+    }
+
+    if (wrap) {
+        m_head = 0;
+    }
+
+    VkDeviceSize offset = m_head;
+
+    m_head += size;
+    m_used += padding + size;
+    m_recordedBytes += padding + size;
+
+    return offset;
+}
+
+VkCommandBuffer UploadManager::begin()
+{
+    if (m_recording) {
+        return m_batches[(m_firstBatch + m_batchCount) % MAX_BATCHES].commandBuffer;
+    }
+
+    while (m_batchCount == MAX_BATCHES) {
+        waitOldest();
+    }
+
+    auto &batch = m_batches[(m_firstBatch + m_batchCount) % MAX_BATCHES];
+
+    vkResetCommandBuffer(batch.commandBuffer, 0);
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    VkResult res = vkBeginCommandBuffer(batch.commandBuffer, &beginInfo);
+    vk::check(res, "Failed to begin upload command buffer");
+
+    m_recording = true;
+
+    return batch.commandBuffer;
+}
+
+void UploadManager::reclaim()
+{
+    VkResult res = vkGetSemaphoreCounterValue(
+        m_device->getDevice(),
+        m_semaphore,
+        &m_completedValue
+    );
+
+    vk::check(res, "Failed to query upload semaphore");
+
+    while (m_batchCount > 0) {
+        auto &batch = m_batches[m_firstBatch];
+        if (batch.value > m_completedValue) {
+            break;
+        }
+
+        m_used -= batch.bytes;
+        m_firstBatch = (m_firstBatch + 1) % MAX_BATCHES;
+        m_batchCount--;
+    }
+
+    if (m_used == 0) {
+        m_head = 0;
+    }
+}
+
+void UploadManager::waitOldest()
+{
+    if (m_batchCount == 0) {
+        submit();
+    }
+
+    VkSemaphoreWaitInfo waitInfo{};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &m_semaphore;
+    waitInfo.pValues = &m_batches[m_firstBatch].value;
+
+    VkResult res = vkWaitSemaphores(m_device->getDevice(), &waitInfo, U64_MAX);
+    vk::check(res, "Failed to wait for upload semaphore");
+
+    reclaim();
+}
+
+} // namespace gfx
\ No newline at end of file
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <array>
+#include <vector>
+#include <cstring>
+
+#include "core/types.hpp"
+
+#include "buffer.hpp"
+
+namespace gfx
+{
+
+class Device;
+
+class UploadManager
+{
+
+public:
+    UploadManager() = default;
+    ~UploadManager() = default;
+
+    void init(Device &device, u32 queueFamily, VkQueue queue);
+    void destroy();
+
+    Buffer uploadBuffer(
+        const void *data,
+        VkDeviceSize size,
+        VkBufferUsageFlags usage
+    );
+
+    template<typename T>
+    Buffer uploadBuffer(const std::vector<T> &data, VkBufferUsageFlags usage);
+
+    // overwrites the start of a buffer made with TRANSFER_DST usage, the
+    // caller keeps it out of use until the upload completes
+    void uploadToBuffer(const Buffer &buffer, const void *data, VkDeviceSize size);
+
+    template<typename T>
+    void uploadToBuffer(const Buffer &buffer, const std::vector<T> &data);
+
+    u64 submit();
+    bool isComplete(u64 value);
+
+public:
+    VkSemaphore getSemaphore() const { return m_semaphore; }
+
+    u64 getPendingValue() const { return m_submittedValue + 1; }
+    u64 getCompletedValue() const { return m_completedValue; }
+
+    u64 getRecordedValue() const { return m_submittedValue + m_recording; }
+
+    static constexpr VkDeviceSize STAGING_SIZE = 32 * 1024 * 1024;
+
+private:
+    static constexpr VkDeviceSize ALIGNMENT = 16;
+    static constexpr u32 MAX_BATCHES = 8;
+
+    struct Batch
+    {
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        u64 value = 0;
+        VkDeviceSize bytes = 0;
+    };
+
+    Device *m_device = nullptr;
+
+    VkQueue m_queue = VK_NULL_HANDLE;
+    VkCommandPool m_commandPool = VK_NULL_HANDLE;
+    VkSemaphore m_semaphore = VK_NULL_HANDLE;
+
+    Buffer m_staging;
+    u8 *m_stagingData = nullptr;
+
+    VkDeviceSize m_head = 0;
+    VkDeviceSize m_used = 0;
+
+    std::array<Batch, MAX_BATCHES> m_batches;
+    u32 m_firstBatch = 0;
+    u32 m_batchCount = 0;
+
+    bool m_recording = false;
+    VkDeviceSize m_recordedBytes = 0;
+
+    u64 m_submittedValue = 0;
+    u64 m_completedValue = 0;
+
+    VkDeviceSize reserve(VkDeviceSize size);
+    VkCommandBuffer begin();
+
+    void reclaim();
+    void waitOldest();
+};
+
+template<typename T>
+Buffer UploadManager::uploadBuffer(
+    const std::vector<T> &data,
+    VkBufferUsageFlags usage
+)
+{
+    return uploadBuffer(data.data(), data.size() * sizeof(T), usage);
+}
+
+template<typename T>
+void UploadManager::uploadToBuffer(const Buffer &buffer, const std::vector<T> &data)
+{
+    uploadToBuffer(buffer, data.data(), data.size() * sizeof(T));
+}
+
+} // namespace gfx
\ No newline at end of file
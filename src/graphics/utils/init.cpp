@@ -171,6 +171,10 @@ VkDevice createLogicalDevice(VkPhysicalDevice physicalDevice, VkSurfaceKHR surfa
         indices.graphicsFamily.value(),
         indices.presentFamily.value()
     };
+
+    if (indices.transferFamily.has_value()) {
+        uniqueQueueFamilies.insert(indices.transferFamily.value());
+    }
     
     float queuePriority = 1.0f;
     for (u32 queueFamily : uniqueQueueFamilies) {
@@ -202,6 +206,8 @@ VkDevice createLogicalDevice(VkPhysicalDevice physicalDevice, VkSurfaceKHR surfa
     vulkan12Features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
     vulkan12Features.descriptorBindingStorageImageUpdateAfterBind = VK_TRUE;
     vulkan12Features.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+    vulkan12Features.timelineSemaphore = VK_TRUE;
+    vulkan12Features.hostQueryReset = VK_TRUE;
     vulkan12Features.pNext = &vulkan13Features;
 
     VkPhysicalDeviceFeatures2 deviceFeatures{};
@@ -209,6 +215,7 @@ VkDevice createLogicalDevice(VkPhysicalDevice physicalDevice, VkSurfaceKHR surfa
     deviceFeatures.features.samplerAnisotropy = VK_TRUE;
     deviceFeatures.features.geometryShader = VK_TRUE;
     deviceFeatures.features.wideLines = VK_TRUE;
+    deviceFeatures.features.pipelineStatisticsQuery = VK_TRUE;
     deviceFeatures.pNext = &vulkan12Features;
     
     std::vector<const char*> deviceExtensions = {
@@ -270,6 +277,27 @@ QueueFamilyIndices findQueueFamilies(
             break;
         }
     }
+
+    // prefer a DMA-only family, then any transfer family without graphics
+    for (u32 i = 0; i < queueFamilyCount; i++) {
+        VkQueueFlags flags = queueFamilies[i].queueFlags;
+
+        if (
+            !(flags & VK_QUEUE_TRANSFER_BIT) ||
+            (flags & VK_QUEUE_GRAPHICS_BIT)
+        ) {
+            continue;
+        }
+
+        if (!(flags & VK_QUEUE_COMPUTE_BIT)) {
+            indices.transferFamily = i;
+            break;
+        }
+
+        if (!indices.transferFamily.has_value()) {
+            indices.transferFamily = i;
+        }
+    }
     
     return indices;
 }
@@ -308,6 +336,23 @@ VkQueue getPresentQueue(
     return queue;
 }
 
+VkQueue getTransferQueue(
+    VkDevice device,
+    QueueFamilyIndices indices,
+    u32 queueIndex
+) 
+{
+    VkQueue queue;
+    vkGetDeviceQueue(
+        device,
+        indices.transferFamily.value_or(indices.graphicsFamily.value()),
+        queueIndex,
+        &queue
+    );
+    
+    return queue;
+}
+
 #ifndef NDEBUG
 
 static VkResult CreateDebugUtilsMessengerEXT(
@@ -703,6 +748,30 @@ VkSemaphore createSemaphore(VkDevice device)
     return semaphore;
 }
 
+VkSemaphore createTimelineSemaphore(VkDevice device, u64 initialValue)
+{
+    VkSemaphoreTypeCreateInfo typeInfo{};
+    typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    typeInfo.initialValue = initialValue;
+
+    VkSemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreInfo.pNext = &typeInfo;
+    
+    VkSemaphore semaphore;
+    VkResult res = vkCreateSemaphore(
+        device,
+        &semaphoreInfo,
+        nullptr,
+        &semaphore
+    );
+
+    check(res, "Failed to create timeline semaphore");
+    
+    return semaphore;
+}
+
 VkFence createFence(VkDevice device, VkFenceCreateFlags flags)
 {
     VkFenceCreateInfo fenceInfo{};
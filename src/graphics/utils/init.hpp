@@ -53,6 +53,7 @@ struct QueueFamilyIndices
 {
     std::optional<u32> graphicsFamily;
     std::optional<u32> presentFamily;
+    std::optional<u32> transferFamily;
 
     bool isComplete() const
     {
@@ -77,6 +78,12 @@ VkQueue getPresentQueue(
     u32 queueIndex = 0
 );
 
+VkQueue getTransferQueue(
+    VkDevice device,
+    QueueFamilyIndices indices,
+    u32 queueIndex = 0
+);
+
 VkDebugUtilsMessengerEXT createDebugMessenger(VkInstance instance);
 
 void destroyDebugMessenger(
@@ -111,6 +118,7 @@ std::vector<VkImageView> createSwapchainImageViews(
 );
 
 VkSemaphore createSemaphore(VkDevice device);
+VkSemaphore createTimelineSemaphore(VkDevice device, u64 initialValue = 0);
 VkFence createFence(VkDevice device, VkFenceCreateFlags flags = 0);
 
 VkCommandPool createCommandPool(
@@ -184,10 +184,110 @@ void GUI::drawGameElements(VkCommandBuffer cmd)
 {
     std::string stat = "Minecraft Vulkan Clone ";
     stat += "(" + std::to_string(m_gameStat.fps) + " fps";
-    stat += ", " + std::to_string(m_gameStat.updatedChunks) + " chunk updates)";
+    stat += ", " + std::to_string(m_gameStat.updatedChunks) + " chunk updates";
+    stat += ", " + std::to_string(static_cast<u32>(m_gameStat.meshTime)) + " us/mesh)";
 
     m_text.draw(cmd, stat, {10.0f, 10.0f}, 32.0f);
 
+    char streaming[128];
+    std::snprintf(
+        streaming,
+        sizeof(streaming),
+        "%d chunks, %.1f ms/tick budget, %.1f ms/frame, %.0f%% used",
+        m_gameStat.renderDistance,
+        m_gameStat.tickBudget,
+        m_gameStat.frameTime,
+        m_gameStat.budgetUsage
+    );
+
+    m_text.draw(cmd, streaming, {10.0f, 42.0f}, 32.0f);
+
+    std::snprintf(
+        streaming,
+        sizeof(streaming),
+        "leading edge: %.2f s to fill, %u missing, %u allocs/tick",
+        m_gameStat.fillTime,
+        m_gameStat.missingChunks,
+        m_gameStat.tickAllocations
+    );
+
+    m_text.draw(cmd, streaming, {10.0f, 74.0f}, 32.0f);
+
+    std::snprintf(
+        streaming,
+        sizeof(streaming),
+        "memory: %.1f KiB CPU, %.1f KiB GPU per chunk",
+        m_gameStat.cpuKiBPerChunk,
+        m_gameStat.gpuKiBPerChunk
+    );
+
+    m_text.draw(cmd, streaming, {10.0f, 106.0f}, 32.0f);
+
+    std::snprintf(
+        streaming,
+        sizeof(streaming),
+        "fragments: %.0fk opaque, %.0fk cutout, %.0fk translucent",
+        m_gameStat.opaqueFragments,
+        m_gameStat.cutoutFragments,
+        m_gameStat.transparentFragments
+    );
+
+    m_text.draw(cmd, streaming, {10.0f, 138.0f}, 32.0f);
+
+    std::snprintf(
+        streaming,
+        sizeof(streaming),
+        "culling: %u/%u chunks, %u sections reachable",
+        m_gameStat.visibleChunks,
+        m_gameStat.loadedChunks,
+        m_gameStat.visibleSections
+    );
+
+    m_text.draw(cmd, streaming, {10.0f, 170.0f}, 32.0f);
+
+    std::snprintf(
+        streaming,
+        sizeof(streaming),
+        "block ticks: %u due, %u scheduled, %u parked, %.0f us/tick",
+        m_gameStat.dueBlockTicks,
+        m_gameStat.scheduledBlockTicks,
+        m_gameStat.parkedBlockTicks,
+        m_gameStat.blockTickTime
+    );
+
+    m_text.draw(cmd, streaming, {10.0f, 202.0f}, 32.0f);
+
+    std::snprintf(
+        streaming,
+        sizeof(streaming),
+        "random ticks: %u sections sampled, %u blocks ticked",
+        m_gameStat.randomTickSections,
+        m_gameStat.randomTicks
+    );
+
+    m_text.draw(cmd, streaming, {10.0f, 234.0f}, 32.0f);
+
+    std::snprintf(
+        streaming,
+        sizeof(streaming),
+        "water: %u flowing cells in %u chunks",
+        m_gameStat.flowingWater,
+        m_gameStat.flowingWaterChunks
+    );
+
+    m_text.draw(cmd, streaming, {10.0f, 266.0f}, 32.0f);
+
+    std::snprintf(
+        streaming,
+        sizeof(streaming),
+        "broadphase: %u entities, %u contacts, %.0f us",
+        m_gameStat.broadphaseEntities,
+        m_gameStat.broadphaseContacts,
+        m_gameStat.broadphaseTime
+    );
+
+    m_text.draw(cmd, streaming, {10.0f, 298.0f}, 32.0f);
+
     for (auto &[_, element] : m_elements) {
         draw(cmd, element);
     }
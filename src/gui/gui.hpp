@@ -4,6 +4,7 @@
 
 #include <vector>
 #include <memory>
+#include <cstdio>
 
 #include "core/window/window.hpp"
 #include "graphics/device.hpp"
@@ -23,6 +24,33 @@ struct GameStat
 {
     u32 fps = 0;
     u32 updatedChunks = 0;
+    f32 meshTime = 0.0f;
+    i32 renderDistance = 0;
+    f32 tickBudget = 0.0f;
+    f32 frameTime = 0.0f;
+    f32 budgetUsage = 0.0f;
+    f32 fillTime = 0.0f;
+    u32 missingChunks = 0;
+    u32 tickAllocations = 0;
+    f32 cpuKiBPerChunk = 0.0f;
+    f32 gpuKiBPerChunk = 0.0f;
+    f32 opaqueFragments = 0.0f;
+    f32 cutoutFragments = 0.0f;
+    f32 transparentFragments = 0.0f;
+    u32 visibleChunks = 0;
+    u32 loadedChunks = 0;
+    u32 visibleSections = 0;
+    u32 dueBlockTicks = 0;
+    u32 scheduledBlockTicks = 0;
+    u32 parkedBlockTicks = 0;
+    f32 blockTickTime = 0.0f;
+    u32 randomTickSections = 0;
+    u32 randomTicks = 0;
+    u32 flowingWater = 0;
+    u32 flowingWaterChunks = 0;
+    u32 broadphaseEntities = 0;
+    u32 broadphaseContacts = 0;
+    f32 broadphaseTime = 0.0f;
     game::GameState state = game::GameState::RUNNING;
 
 };
@@ -3,6 +3,12 @@
 
 #include "binding.glsl"
 
+#define MODE_OPAQUE 0
+#define MODE_CUTOUT 1
+#define MODE_TRANSLUCENT 2
+
+layout(constant_id = 0) const uint RENDER_MODE = MODE_TRANSLUCENT;
+
 layout(location = 0) out vec4 outColor;
 
 layout(location = 0) in vec2 fragUV;
@@ -14,6 +20,7 @@ layout(location = 4) in flat uint faceDirection;
 layout(push_constant) uniform PushConstantObject {
     mat4 model;
     uint textureId;
+    float fogEnd;
 } pco;
 
 vec3 addShadow(vec3 color)
@@ -35,8 +42,8 @@ vec3 addShadow(vec3 color)
 
 vec3 addFog(vec3 color, float dist)
 {
-    float fogStart = 4.0 * 16.0;
-    float fogEnd = 7.0 * 16.0;
+    float fogEnd = pco.fogEnd;
+    float fogStart = fogEnd * 4.0 / 7.0;
     vec3 fogColor = vec3(0.73, 0.83, 1.0);
 
     float fogFactor = 1.0 - clamp(
@@ -54,15 +61,25 @@ void main()
 {
     float dist = length(worldPos - camPos);
 
-    vec3 color = texture(texArr[pco.textureId], fragUV).rgb;
-    float alpha = texture(texArr[pco.textureId], fragUV).a;
-
-    if (alpha > 0.1 && alpha < 0.9) {
-        alpha = 0.8;
-    }
-
-    if (alpha < 0.1) {
-        discard;
+    vec4 texel = texture(texArr[pco.textureId], fragUV);
+    vec3 color = texel.rgb;
+    float alpha = 1.0;
+
+    // opaque terrain must not discard so early depth testing stays enabled
+    if (RENDER_MODE == MODE_CUTOUT) {
+        if (texel.a < 0.1) {
+            discard;
+        }
+    } else if (RENDER_MODE == MODE_TRANSLUCENT) {
+        alpha = texel.a;
+
+        if (alpha > 0.1 && alpha < 0.9) {
+            alpha = 0.8;
+        }
+
+        if (alpha < 0.1) {
+            discard;
+        }
     }
 
     color = addShadow(color);
@@ -17,6 +17,7 @@ layout(location = 4) out flat uint faceDirection;
 layout(push_constant) uniform PushConstantObject {
     mat4 model;
     uint textureId;
+    float fogEnd;
 } pco;
 
 void main()
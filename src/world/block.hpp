@@ -63,6 +63,10 @@ struct Block
     bool collision = true;
     bool breakable = true;
     bool cross = false;
+    bool cutout = false;
+    bool falling = false;
+    bool randomTicks = false;
+    u32 tickDelay = 0;
     std::string material = "none";
 };
 
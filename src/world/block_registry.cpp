@@ -77,6 +77,34 @@ BlockRegistry::BlockRegistry()
                     ->value_or(false);
             }
 
+            if (blockTable->contains("cutout")) {
+                block.cutout = blockTable
+                    ->get("cutout")
+                    ->as_boolean()
+                    ->value_or(false);
+            }
+
+            if (blockTable->contains("falling")) {
+                block.falling = blockTable
+                    ->get("falling")
+                    ->as_boolean()
+                    ->value_or(false);
+            }
+
+            if (blockTable->contains("random_ticks")) {
+                block.randomTicks = blockTable
+                    ->get("random_ticks")
+                    ->as_boolean()
+                    ->value_or(false);
+            }
+
+            if (blockTable->contains("tick_delay")) {
+                block.tickDelay = static_cast<u32>(blockTable
+                    ->get("tick_delay")
+                    ->as_integer()
+                    ->value_or(0));
+            }
+
             if (blockTable->contains("material")) {
                 block.material = blockTable
                     ->get("material")
@@ -0,0 +1,69 @@
+#include "block_ticker.hpp"
+
+namespace wld
+{
+
+bool BlockTicker::schedule(const glm::ivec3 &pos, BlockType block, u64 due)
+{
+    if (!m_pending.insert(pos).second) {
+        return false;
+    }
+
+    m_slots[due % WHEEL_SIZE].push_back({pos, block, due});
+    return true;
+}
+
+void BlockTicker::advance(u64 now, std::vector<ScheduledTick> &due)
+{
+    auto &slot = m_slots[now % WHEEL_SIZE];
+
+    for (usize i = 0; i < slot.size();) {
+        if (slot[i].due > now) {
+            i++;
+            continue;
+        }
+
+        m_pending.erase(slot[i].pos);
+        due.push_back(slot[i]);
+
+        slot[i] = slot.back();
+        slot.pop_back();
+    }
+}
+
+void BlockTicker::park(const ChunkPos &pos, const ScheduledTick &tick)
+{
+    if (m_pending.insert(tick.pos).second) {
+        m_buckets[pos].push_back(tick);
+        m_parked++;
+    }
+}
+
+void BlockTicker::restore(const ChunkPos &pos, u64 now)
+{
+    auto it = m_buckets.find(pos);
+    if (it == m_buckets.end()) {
+        return;
+    }
+
+    for (auto &tick : it->second) {
+        tick.due = std::max(tick.due, now + 1);
+        m_slots[tick.due % WHEEL_SIZE].push_back(tick);
+    }
+
+    m_parked -= it->second.size();
+    m_buckets.erase(it);
+}
+
+void BlockTicker::clear()
+{
+    for (auto &slot : m_slots) {
+        slot.clear();
+    }
+
+    m_pending.clear();
+    m_buckets.clear();
+    m_parked = 0;
+}
+
+} // namespace wld
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "chunk.hpp"
+
+namespace wld
+{
+
+struct BlockPosHash
+{
+    std::size_t operator()(const glm::ivec3 &pos) const {
+        return std::hash<int>()(pos.x) ^
+            (std::hash<int>()(pos.y) << 1) ^
+            (std::hash<int>()(pos.z) << 2);
+    }
+};
+
+struct ScheduledTick
+{
+    glm::ivec3 pos;
+    BlockType block;
+    u64 due;
+};
+
+// hashed timing wheel of block updates, a tick lands in slot due % size
+// and only the slot of the current tick is looked at; ticks of chunks
+// that are not loaded wait in per chunk buckets until the chunk returns
+class BlockTicker
+{
+
+public:
+    static constexpr u64 WHEEL_SIZE = 256;
+
+    // at most one pending tick per position, returns false if the
+    // position already has one
+    bool schedule(const glm::ivec3 &pos, BlockType block, u64 due);
+
+    // moves every tick due at now into due, later turns stay in the slot
+    void advance(u64 now, std::vector<ScheduledTick> &due);
+
+    void park(const ChunkPos &pos, const ScheduledTick &tick);
+    void restore(const ChunkPos &pos, u64 now);
+
+    void clear();
+
+    usize getScheduled() const { return m_pending.size() - m_parked; }
+    usize getParked() const { return m_parked; }
+
+private:
+    std::array<std::vector<ScheduledTick>, WHEEL_SIZE> m_slots;
+
+    std::unordered_set<glm::ivec3, BlockPosHash> m_pending;
+
+    using ParkedMap = std::unordered_map<ChunkPos,
+        std::vector<ScheduledTick>,
+        ChunkPosHash>;
+
+    ParkedMap m_buckets;
+    usize m_parked = 0;
+};
+
+} // namespace wld
\ No newline at end of file
@@ -11,6 +11,18 @@ Chunk::Chunk(World &world, const ChunkPos &pos) :
 {
     m_blocks.fill(BlockType::AIR);
     m_lights.fill(15);
+    m_waterLevels.fill(0);
+    clearFlags();
+}
+
+void Chunk::reset(const ChunkPos &pos)
+{
+    m_pos = pos;
+
+    m_blocks.fill(BlockType::AIR);
+    m_lights.fill(15);
+    m_waterLevels.fill(0);
+    clearFlags();
 }
 
 void Chunk::update()
@@ -22,14 +34,15 @@ void Chunk::update()
 
 void Chunk::propagateLight()
 {
-    std::queue<LightNode> lightQueue;
+    thread_local std::vector<LightNode> lightQueue;
+    lightQueue.clear();
 
     for (int x = 0; x < CHUNK_SIZE; x++) {
         for (int z = 0; z < CHUNK_SIZE; z++) {
             for (int y = 0; y < CHUNK_HEIGHT; y++) {
                 u8 lightLevel = getLight(x, y, z);
                 if (lightLevel > 0) {
-                    lightQueue.push({x, y, z, lightLevel});
+                    lightQueue.push_back({x, y, z, lightLevel});
                 }
             }
         }
@@ -44,9 +57,8 @@ void Chunk::propagateLight()
         glm::ivec3(0, 0, -1)
     };
 
-    while (!lightQueue.empty()) {
-        LightNode node = lightQueue.front();
-        lightQueue.pop();
+    for (usize head = 0; head < lightQueue.size(); head++) {
+        LightNode node = lightQueue[head];
 
         for (const auto &dir : directions) {
             glm::ivec3 adjPos = glm::ivec3(node.x, node.y, node.z) + dir;
@@ -74,7 +86,7 @@ void Chunk::propagateLight()
 
                 if (propagatedLight > currentLight) {
                     setLight(adjPos.x, adjPos.y, adjPos.z, propagatedLight);
-                    lightQueue.push({adjPos.x, adjPos.y, adjPos.z, propagatedLight});
+                    lightQueue.push_back({adjPos.x, adjPos.y, adjPos.z, propagatedLight});
                 }
             }
         }
@@ -91,7 +103,24 @@ void Chunk::setBlock(int x, int y, int z, BlockType type)
         return;
     }
 
-    m_blocks[getIndex(x, y, z)] = type;
+    const auto &registry = BlockRegistry::get();
+    BlockType &current = m_blocks[getIndex(x, y, z)];
+    u16 &randomTicks = m_randomTicks[y / SectionConnectivity::SECTION_SIZE];
+
+    randomTicks -= registry.getBlock(current).randomTicks;
+    current = type;
+
+    const Block &block = registry.getBlock(type);
+    bool solid = type != BlockType::AIR;
+
+    randomTicks += block.randomTicks;
+
+    setWaterLevel(x, y, z, 0);
+
+    setFlag(BlockFlag::COLLIDABLE, x, y, z, solid && block.collision);
+    setFlag(BlockFlag::OPAQUE, x, y, z,
+        solid && !block.transparency && !block.cross && !block.cutout);
+    setFlag(BlockFlag::TARGETABLE, x, y, z, solid && block.breakable);
 }
 
 void Chunk::setLight(int x, int y, int z, u8 light)
@@ -107,6 +136,37 @@ void Chunk::setLight(int x, int y, int z, u8 light)
     m_lights[getIndex(x, y, z)] = light;
 }
 
+void Chunk::setWaterLevel(int x, int y, int z, u8 level)
+{
+    if (
+        x < 0 || x >= CHUNK_SIZE ||
+        y < 0 || y >= CHUNK_HEIGHT ||
+        z < 0 || z >= CHUNK_SIZE
+    ) {
+        return;
+    }
+
+    int index = getIndex(x, y, z);
+    int shift = (index & 1) * 4;
+
+    u8 &nibbles = m_waterLevels[index >> 1];
+    nibbles = static_cast<u8>((nibbles & ~(0xF << shift)) | ((level & 0xF) << shift));
+}
+
+u8 Chunk::getWaterLevel(int x, int y, int z) const
+{
+    if (
+        x < 0 || x >= CHUNK_SIZE ||
+        y < 0 || y >= CHUNK_HEIGHT ||
+        z < 0 || z >= CHUNK_SIZE
+    ) {
+        return 0;
+    }
+
+    int index = getIndex(x, y, z);
+    return (m_waterLevels[index >> 1] >> ((index & 1) * 4)) & 0xF;
+}
+
 BlockType Chunk::getBlock(int x, int y, int z) const
 {
     if (
@@ -133,6 +193,75 @@ u8 Chunk::getLight(int x, int y, int z) const
     return m_lights[getIndex(x, y, z)];
 }
 
+bool Chunk::hasFlag(BlockFlag flag, int x, int y, int z) const
+{
+    if (
+        x < 0 || x >= CHUNK_SIZE ||
+        y < 0 || y >= CHUNK_HEIGHT ||
+        z < 0 || z >= CHUNK_SIZE
+    ) {
+        return false;
+    }
+
+    return (getColumnWord(flag, x, z, y >> 6) >> (y & 63)) & 1;
+}
+
+u64 Chunk::getColumnBits(
+    BlockFlag flag,
+    int x,
+    int z,
+    int word,
+    int minY,
+    int maxY
+) const
+{
+    int low = std::max(minY - word * 64, 0);
+    int high = std::min(maxY - word * 64, 63);
+
+    if (low > high) {
+        return 0;
+    }
+
+    u64 mask = (~0ull >> (63 - high)) & (~0ull << low);
+    return getColumnWord(flag, x, z, word) & mask;
+}
+
+bool Chunk::anyInColumn(BlockFlag flag, int x, int z, int minY, int maxY) const
+{
+    if (x < 0 || x >= CHUNK_SIZE || z < 0 || z >= CHUNK_SIZE) {
+        return false;
+    }
+
+    for (int word = 0; word < COLUMN_WORDS; word++) {
+        if (getColumnBits(flag, x, z, word, minY, maxY)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Chunk::setFlag(BlockFlag flag, int x, int y, int z, bool value)
+{
+    u64 &word = m_flags[static_cast<usize>(flag)][getColumnIndex(x, z) + (y >> 6)];
+    u64 bit = 1ull << (y & 63);
+
+    if (value) {
+        word |= bit;
+    } else {
+        word &= ~bit;
+    }
+}
+
+void Chunk::clearFlags()
+{
+    for (auto &columns : m_flags) {
+        columns.fill(0);
+    }
+
+    m_randomTicks.fill(0);
+}
+
 void Chunk::calulateSkyLight()
 {
     for (int x = 0; x < CHUNK_SIZE; x++) {
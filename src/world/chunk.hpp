@@ -1,9 +1,11 @@
 #pragma once
 
 #include <array>
+#include <functional>
 
 #include "core/types.hpp"
 #include "world/block.hpp"
+#include "world/section_connectivity.hpp"
 
 namespace wld
 {
@@ -39,6 +41,21 @@ struct ChunkPos
     }
 };
 
+struct ChunkPosHash
+{
+    std::size_t operator()(const ChunkPos &pos) const {
+        return std::hash<int>()(pos.x) ^ (std::hash<int>()(pos.z) << 1);
+    }
+};
+
+enum class BlockFlag
+{
+    COLLIDABLE,
+    OPAQUE,
+    TARGETABLE,
+    COUNT
+};
+
 struct LightNode
 {
     int x, y, z;
@@ -51,9 +68,18 @@ class Chunk
 public:
     static constexpr int CHUNK_SIZE = 16;
     static constexpr int CHUNK_HEIGHT = 128;
+    static constexpr int COLUMN_WORDS = CHUNK_HEIGHT / 64;
+
+    // water levels, 0 is a source, 1 to 7 flow further from it and
+    // WATER_FALLING pours down from the block above
+    static constexpr u8 WATER_SOURCE = 0;
+    static constexpr u8 WATER_MAX_LEVEL = 7;
+    static constexpr u8 WATER_FALLING = 8;
 
     Chunk(World &world, const ChunkPos &pos);
 
+    void reset(const ChunkPos &pos);
+
     void update();
     void propagateLight();
 
@@ -71,7 +97,31 @@ public:
 
     u8 getLight(int x, int y, int z) const;
 
-    
+    // setBlock resets the level of the block to 0
+    void setWaterLevel(int x, int y, int z, u8 level);
+    u8 getWaterLevel(int x, int y, int z) const;
+
+    // every column keeps one bit per block and flag, bit y % 64 of word
+    // y / 64, so queries never touch the block array
+    bool hasFlag(BlockFlag flag, int x, int y, int z) const;
+    u64 getColumnWord(BlockFlag flag, int x, int z, int word) const {
+        return m_flags[static_cast<usize>(flag)][getColumnIndex(x, z) + word];
+    }
+
+    // bits of the column word between minY and maxY inclusive
+    u64 getColumnBits(
+        BlockFlag flag,
+        int x,
+        int z,
+        int word,
+        int minY,
+        int maxY
+    ) const;
+
+    bool anyInColumn(BlockFlag flag, int x, int z, int minY, int maxY) const;
+
+    bool hasRandomTicks(int section) const { return m_randomTicks[section] > 0; }
+
 private:
     World &m_world;
     ChunkPos m_pos;
@@ -79,10 +129,26 @@ private:
     std::array<BlockType, CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE> m_blocks;
     std::array<u8, CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE> m_lights;
 
+    // one nibble per block
+    std::array<u8, CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE / 2> m_waterLevels;
+
+    using FlagColumns = std::array<u64, CHUNK_SIZE * CHUNK_SIZE * COLUMN_WORDS>;
+    std::array<FlagColumns, static_cast<usize>(BlockFlag::COUNT)> m_flags;
+
+    // blocks taking random ticks per section
+    std::array<u16, SectionConnectivity::SECTION_COUNT> m_randomTicks;
+
     int getIndex(int x, int y, int z) const {
         return y * CHUNK_SIZE * CHUNK_SIZE + z * CHUNK_SIZE + x;
     }
 
+    int getColumnIndex(int x, int z) const {
+        return (z * CHUNK_SIZE + x) * COLUMN_WORDS;
+    }
+
+    void setFlag(BlockFlag flag, int x, int y, int z, bool value);
+    void clearFlags();
+
     void calulateSkyLight();
 };
 
@@ -1,7 +1,7 @@
 #include "chunk_mesh.hpp"
 #include "block_registry.hpp"
+#include "face_masks.hpp"
 #include "world.hpp"
-#include "block_registry.hpp"
 
 namespace wld
 {
@@ -13,34 +13,100 @@ void ChunkMesh::init(gfx::Device &device)
 
 void ChunkMesh::destroy()
 {
-    m_device->waitIdle();
-
-    m_indexBuffer.destroy();
-    m_vertexBuffer.destroy();
-    m_transparentIndexBuffer.destroy();
-    m_transparentVertexBuffer.destroy();
-    m_crossIndexBuffer.destroy();
-    m_crossVertexBuffer.destroy();
+    retire(m_buffers);
+    retire(m_pending);
+    m_device->retire(m_sortBuffer);
+
+    m_sortBuffer = gfx::Buffer{};
+    m_hasPending = false;
+    m_hasSorted = false;
+}
+
+void ChunkMesh::Geometry::clear()
+{
+    vertices.clear();
+    indices.clear();
+    transparentVertices.clear();
+    transparentIndices.clear();
+    crossVertices.clear();
+    crossIndices.clear();
+
+    minY = static_cast<f32>(Chunk::CHUNK_HEIGHT);
+    maxY = 0.0f;
+
+    sectionStarts = {};
+}
+
+void ChunkMesh::Geometry::markSection(int section)
+{
+    sectionStarts[static_cast<u32>(Pass::OPAQUE)][section] =
+        static_cast<u32>(indices.size());
+    sectionStarts[static_cast<u32>(Pass::TRANSPARENT)][section] =
+        static_cast<u32>(transparentIndices.size());
+    sectionStarts[static_cast<u32>(Pass::CROSS)][section] =
+        static_cast<u32>(crossIndices.size());
 }
 
-void ChunkMesh::generate(
+usize ChunkMesh::Geometry::getCapacityBytes() const
+{
+    usize vertexCount = vertices.capacity() +
+        transparentVertices.capacity() +
+        crossVertices.capacity();
+
+    usize indexCount = indices.capacity() +
+        transparentIndices.capacity() +
+        crossIndices.capacity();
+
+    return vertexCount * sizeof(Vertex) + indexCount * sizeof(u32);
+}
+
+void ChunkMesh::build(
     const Chunk &chunk,
-    const std::array<const Chunk *, 4> &neighbors
+    const std::array<const Chunk *, 4> &neighbors,
+    FaceMasks &masks,
+    Geometry &geometry
 )
 {
+    // emitted per block in this order
+    static const std::array<std::pair<Face, const std::array<glm::vec3, 4> *>, 6> faces = {{
+        {Face::WEST, &FACE_WEST},
+        {Face::EAST, &FACE_EAST},
+        {Face::BOTTOM, &FACE_BOTTOM},
+        {Face::TOP, &FACE_TOP},
+        {Face::NORTH, &FACE_NORTH},
+        {Face::SOUTH, &FACE_SOUTH}
+    }};
+
+    geometry.clear();
+    geometry.connectivity.build(chunk);
+
+    masks.build(chunk, neighbors);
+
     for (u32 y = 0; y < Chunk::CHUNK_HEIGHT; y++) {
+        if (y % SectionConnectivity::SECTION_SIZE == 0) {
+            geometry.markSection(y / SectionConnectivity::SECTION_SIZE);
+        }
+
         for (u32 z = 0; z < Chunk::CHUNK_SIZE; z++) {
-            for (u32 x = 0; x < Chunk::CHUNK_SIZE; x++) {
-                BlockType block = chunk.getBlock(x, y, z);
-                if (block == BlockType::AIR) {
-                    continue;
-                }
+            std::array<u32, 6> faceBits;
+            u32 cross = masks.getCross(y, z);
+            u32 blocks = cross;
+
+            for (usize i = 0; i < faces.size(); i++) {
+                faceBits[i] = masks.getFaces(y, z, faces[i].first);
+                blocks |= faceBits[i];
+            }
+
+            while (blocks) {
+                u32 x = FaceMasks::popLowest(blocks);
+                u32 bit = 1u << x;
 
+                BlockType block = chunk.getBlock(x, y, z);
                 glm::vec3 pos(x, y, z);
 
-                
-                if (wld::BlockRegistry::get().getBlock(block).cross) {
+                if (cross & bit) {
                     addFace(
+                        geometry,
                         chunk,
                         neighbors,
                         pos,
@@ -51,6 +117,7 @@ void ChunkMesh::generate(
                     );
 
                     addFace(
+                        geometry,
                         chunk,
                         neighbors,
                         pos,
@@ -63,217 +130,326 @@ void ChunkMesh::generate(
                     continue;
                 }
 
-                if (isFaceVisible(chunk, neighbors, x - 1, y, z, block)) {
-                    addFace(
-                        chunk,
-                        neighbors,
-                        pos,
-                        ChunkMesh::FACE_WEST,
-                        getUVs(block, Face::WEST),
-                        block,
-                        Face::WEST
-                    );
-                }
-
-                if (isFaceVisible(chunk, neighbors, x + 1, y, z, block)) {
-                    addFace(
-                        chunk,
-                        neighbors,
-                        pos,
-                        ChunkMesh::FACE_EAST,
-                        getUVs(block, Face::EAST),
-                        block,
-                        Face::EAST
-                    );
-                }
+                for (usize i = 0; i < faces.size(); i++) {
+                    if (!(faceBits[i] & bit)) {
+                        continue;
+                    }
 
-                if (isFaceVisible(chunk, neighbors, x, y - 1, z, block)) {
                     addFace(
+                        geometry,
                         chunk,
                         neighbors,
                         pos,
-                        ChunkMesh::FACE_BOTTOM,
-                        getUVs(block, Face::BOTTOM),
+                        *faces[i].second,
+                        getUVs(block, faces[i].first),
                         block,
-                        Face::BOTTOM
+                        faces[i].first
                     );
                 }
+            }
+        }
+    }
 
-                if (isFaceVisible(chunk, neighbors, x, y + 1, z, block)) {
-                    addFace(
-                        chunk,
-                        neighbors,
-                        pos,
-                        ChunkMesh::FACE_TOP,
-                        getUVs(block, Face::TOP),
-                        block,
-                        Face::TOP
-                    );
-                }
+    geometry.markSection(SectionConnectivity::SECTION_COUNT);
+}
 
-                if (isFaceVisible(chunk, neighbors, x, y, z + 1, block)) {
-                    addFace(
-                        chunk,
-                        neighbors,
-                        pos,
-                        ChunkMesh::FACE_NORTH,
-                        getUVs(block, Face::NORTH),
-                        block,
-                        Face::NORTH
-                    );
-                }
+void ChunkMesh::upload(const Geometry &geometry)
+{
+    auto &uploads = m_device->getUploadManager();
 
-                if (isFaceVisible(chunk, neighbors, x, y, z - 1, block)) {
-                    addFace(
-                        chunk,
-                        neighbors,
-                        pos,
-                        ChunkMesh::FACE_SOUTH,
-                        getUVs(block, Face::SOUTH),
-                        block,
-                        Face::SOUTH
-                    );
-                }
-            }
-        }
-    };
+    // a newer upload supersedes one that has not landed yet
+    retire(m_pending);
 
-    m_vertexBuffer = m_device->createBuffer(
-        m_vertices.size() * sizeof(Vertex),
-        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-        VMA_MEMORY_USAGE_CPU_TO_GPU 
+    m_pending.vertexBuffer = uploads.uploadBuffer(
+        geometry.vertices,
+        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT
     );
 
-    m_vertexBuffer.uploadData(m_vertices);
-
-    m_indexBuffer = m_device->createBuffer(
-        m_indices.size() * sizeof(u32),
-        VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-        VMA_MEMORY_USAGE_CPU_TO_GPU 
+    m_pending.indexBuffer = uploads.uploadBuffer(
+        geometry.indices,
+        VK_BUFFER_USAGE_INDEX_BUFFER_BIT
     );
 
-    m_indexBuffer.uploadData(m_indices);
+    m_pending.transparentVertexBuffer = uploads.uploadBuffer(
+        geometry.transparentVertices,
+        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT
+    );
 
-    m_transparentVertexBuffer = m_device->createBuffer(
-        m_transparentVertices.size() * sizeof(Vertex),
-        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-        VMA_MEMORY_USAGE_CPU_TO_GPU 
+    m_pending.transparentIndexBuffer = uploads.uploadBuffer(
+        geometry.transparentIndices,
+        VK_BUFFER_USAGE_INDEX_BUFFER_BIT
     );
 
-    m_transparentVertexBuffer.uploadData(m_transparentVertices);
+    m_pending.crossVertexBuffer = uploads.uploadBuffer(
+        geometry.crossVertices,
+        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT
+    );
 
-    m_transparentIndexBuffer = m_device->createBuffer(
-        m_transparentIndices.size() * sizeof(u32),
-        VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-        VMA_MEMORY_USAGE_CPU_TO_GPU 
+    m_pending.crossIndexBuffer = uploads.uploadBuffer(
+        geometry.crossIndices,
+        VK_BUFFER_USAGE_INDEX_BUFFER_BIT
     );
 
-    m_transparentIndexBuffer.uploadData(m_transparentIndices);
+    m_pending.indexCount = static_cast<u32>(geometry.indices.size());
+    m_pending.transparentIndexCount = static_cast<u32>(geometry.transparentIndices.size());
+    m_pending.crossIndexCount = static_cast<u32>(geometry.crossIndices.size());
 
-    m_crossVertexBuffer = m_device->createBuffer(
-        m_crossVertices.size() * sizeof(Vertex),
-        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-        VMA_MEMORY_USAGE_CPU_TO_GPU 
-    );
+    m_pending.minY = geometry.minY;
+    m_pending.maxY = geometry.maxY;
 
-    m_crossVertexBuffer.uploadData(m_crossVertices);
+    m_pending.sectionStarts = geometry.sectionStarts;
+    m_pending.connectivity = geometry.connectivity;
 
-    m_crossIndexBuffer = m_device->createBuffer(
-        m_crossIndices.size() * sizeof(u32),
-        VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-        VMA_MEMORY_USAGE_CPU_TO_GPU 
-    );
+    const auto &transparent = geometry.transparentVertices;
+    m_pendingCenters.clear();
+
+    for (usize i = 0; i + 3 < transparent.size(); i += 4) {
+        m_pendingCenters.push_back(
+            (transparent[i].pos + transparent[i + 2].pos) * 0.5f
+        );
+    }
 
-    m_crossIndexBuffer.uploadData(m_crossIndices);
+    m_pendingValue = uploads.getPendingValue();
+    m_hasPending = true;
 }
 
-void ChunkMesh::update(
-    const Chunk &chunk,
-    const std::array<const Chunk *, 4> &neighbors
-)
+bool ChunkMesh::poll()
 {
-    m_vertices.clear();
-    m_indices.clear();
-    m_transparentVertices.clear();
-    m_transparentIndices.clear();
-    m_crossVertices.clear();
-    m_crossIndices.clear();
-
-    m_device->waitIdle();
-
-    m_vertexBuffer.destroy();
-    m_indexBuffer.destroy();
-    m_transparentVertexBuffer.destroy();
-    m_transparentIndexBuffer.destroy();
-    m_crossIndexBuffer.destroy();
-    m_crossVertexBuffer.destroy();
-
-    generate(chunk, neighbors);
+    if (
+        m_hasPending &&
+        m_device->getUploadManager().isComplete(m_pendingValue)
+    ) {
+        retire(m_buffers);
+
+        m_buffers = m_pending;
+        m_pending = Buffers{};
+        m_hasPending = false;
+
+        m_transparentCenters.swap(m_pendingCenters);
+        m_sortDirty = true;
+
+        // a sort still in flight was built for the replaced geometry, the
+        // spare stays busy until its copy lands
+        m_hasSorted = false;
+    }
+
+    return !m_hasPending;
 }
 
-void ChunkMesh::drawOpaque(VkCommandBuffer cmd)
+bool ChunkMesh::sortTransparent(const glm::vec3 &cameraPos)
 {
-    if (m_vertices.empty()) {
-        return;
+    auto &uploads = m_device->getUploadManager();
+
+    if (m_hasSorted) {
+        if (!uploads.isComplete(m_sortValue)) {
+            return false;
+        }
+
+        std::swap(m_buffers.transparentIndexBuffer, m_sortBuffer);
+        m_sortFrame = m_device->getFrameCount();
+        m_hasSorted = false;
     }
 
-    VkDeviceSize offsets[] = {0};
-    
-    VkBuffer vertexBuffer = m_vertexBuffer.getBuffer();
-    vkCmdBindVertexBuffers(
-        cmd,
-        0,
-        1,
-        &vertexBuffer,
-        offsets
+    if (m_hasPending || m_transparentCenters.size() < 2) {
+        return false;
+    }
+
+    glm::vec3 toCenter = cameraPos - glm::vec3(
+        Chunk::CHUNK_SIZE * 0.5f,
+        cameraPos.y,
+        Chunk::CHUNK_SIZE * 0.5f
     );
 
-    vkCmdBindIndexBuffer(
-        cmd,
-        m_indexBuffer.getBuffer(),
-        0,
-        VK_INDEX_TYPE_UINT32
+    f32 resortDistance = std::max(
+        RESORT_DISTANCE,
+        glm::length(toCenter) * RESORT_DISTANCE_SCALE
     );
 
-    vkCmdDrawIndexed(cmd, m_indices.size(), 1, 0, 0, 0);
+    glm::vec3 moved = cameraPos - m_sortOrigin;
+    if (!m_sortDirty && glm::dot(moved, moved) < resortDistance * resortDistance) {
+        return false;
+    }
+
+    // the spare may still be read by frames in flight or written by a
+    // discarded sort
+    if (!m_device->isReleased(m_sortFrame) || !uploads.isComplete(m_sortValue)) {
+        return false;
+    }
+
+    // sorts only run from prepareRender, so one scratch serves every mesh
+    static thread_local std::vector<std::pair<f32, u32>> order;
+    static thread_local std::vector<u32> indices;
+
+    order.resize(m_transparentCenters.size());
+
+    for (u32 i = 0; i < order.size(); i++) {
+        glm::vec3 offset = m_transparentCenters[i] - cameraPos;
+        order[i] = {glm::dot(offset, offset), i};
+    }
+
+    std::sort(order.begin(), order.end(), [](const auto &a, const auto &b) {
+        return a.first > b.first;
+    });
+
+    indices.clear();
+    indices.reserve(order.size() * 6);
+
+    // quads keep their vertices, only the index order changes
+    for (const auto &[distance, quad] : order) {
+        u32 base = quad * 4;
+
+        indices.push_back(base + 0);
+        indices.push_back(base + 1);
+        indices.push_back(base + 2);
+        indices.push_back(base + 2);
+        indices.push_back(base + 3);
+        indices.push_back(base + 0);
+    }
+
+    VkDeviceSize size = indices.size() * sizeof(u32);
+
+    // a new buffer is only needed when the geometry outgrows the spare
+    if (m_sortBuffer.getSize() < size) {
+        m_device->retire(m_sortBuffer);
+        m_sortBuffer = m_device->createBuffer(
+            size,
+            VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VMA_MEMORY_USAGE_GPU_ONLY
+        );
+    }
+
+    uploads.uploadToBuffer(m_sortBuffer, indices);
+    m_sortValue = uploads.getPendingValue();
+    m_hasSorted = true;
+
+    m_sortOrigin = cameraPos;
+    m_sortDirty = false;
+
+    return true;
+}
+
+usize ChunkMesh::Buffers::getSize() const
+{
+    return vertexBuffer.getSize() +
+        indexBuffer.getSize() +
+        transparentVertexBuffer.getSize() +
+        transparentIndexBuffer.getSize() +
+        crossVertexBuffer.getSize() +
+        crossIndexBuffer.getSize();
+}
+
+usize ChunkMesh::getGpuBytes() const
+{
+    return m_buffers.getSize() +
+        m_pending.getSize() +
+        m_sortBuffer.getSize();
 }
 
-void ChunkMesh::drawTransparent(VkCommandBuffer cmd)
+void ChunkMesh::retire(Buffers &buffers)
 {
-    if (m_transparentVertices.empty()) {
+    m_device->retire(buffers.vertexBuffer);
+    m_device->retire(buffers.indexBuffer);
+    m_device->retire(buffers.transparentVertexBuffer);
+    m_device->retire(buffers.transparentIndexBuffer);
+    m_device->retire(buffers.crossVertexBuffer);
+    m_device->retire(buffers.crossIndexBuffer);
+
+    buffers = Buffers{};
+}
+
+void ChunkMesh::draw(VkCommandBuffer cmd, Pass pass, u8 sections)
+{
+    IndexRange range = getIndexRange(pass, sections);
+    if (range.count == 0) {
         return;
     }
 
-    VkDeviceSize offsets[] = {0};
+    if (bind(cmd, pass)) {
+        vkCmdDrawIndexed(cmd, range.count, 1, range.first, 0, 0);
+    }
+}
 
-    VkBuffer vertexBuffer = m_transparentVertexBuffer.getBuffer();
-    vkCmdBindVertexBuffers(
-        cmd,
-        0,
-        1,
-        &vertexBuffer,
-        offsets
-    );
+void ChunkMesh::drawIndirect(
+    VkCommandBuffer cmd,
+    Pass pass,
+    VkBuffer buffer,
+    VkDeviceSize offset
+)
+{
+    if (bind(cmd, pass)) {
+        vkCmdDrawIndexedIndirect(
+            cmd,
+            buffer,
+            offset,
+            1,
+            sizeof(VkDrawIndexedIndirectCommand)
+        );
+    }
+}
 
-    vkCmdBindIndexBuffer(
-        cmd,
-        m_transparentIndexBuffer.getBuffer(),
-        0,
-        VK_INDEX_TYPE_UINT32
-    );
+u32 ChunkMesh::getIndexCount(Pass pass) const
+{
+    switch (pass)
+    {
+
+    case Pass::OPAQUE:
+        return m_buffers.indexCount;
+
+    case Pass::TRANSPARENT:
+        return m_buffers.transparentIndexCount;
 
-    vkCmdDrawIndexed(cmd, m_transparentIndices.size(), 1, 0, 0, 0);
+    case Pass::CROSS:
+        return m_buffers.crossIndexCount;
+    }
+
+    return 0;
 }
 
-void ChunkMesh::drawCross(VkCommandBuffer cmd)
+ChunkMesh::IndexRange ChunkMesh::getIndexRange(Pass pass, u8 sections) const
 {
-    if (m_crossVertices.empty()) {
-        return;
+    if (sections == 0) {
+        return {0, 0};
+    }
+
+    // sorting reorders translucent quads across sections
+    if (pass == Pass::TRANSPARENT) {
+        return {0, m_buffers.transparentIndexCount};
+    }
+
+    int low = SectionConnectivity::getLowestSection(sections);
+    int high = SectionConnectivity::getHighestSection(sections);
+
+    const auto &starts = m_buffers.sectionStarts[static_cast<u32>(pass)];
+    return {starts[low], starts[high + 1] - starts[low]};
+}
+
+bool ChunkMesh::isEmpty() const
+{
+    return m_buffers.indexCount == 0 &&
+        m_buffers.transparentIndexCount == 0 &&
+        m_buffers.crossIndexCount == 0;
+}
+
+bool ChunkMesh::bind(VkCommandBuffer cmd, Pass pass)
+{
+    if (getIndexCount(pass) == 0) {
+        return false;
+    }
+
+    const gfx::Buffer *vertices = &m_buffers.vertexBuffer;
+    const gfx::Buffer *indices = &m_buffers.indexBuffer;
+
+    if (pass == Pass::TRANSPARENT) {
+        vertices = &m_buffers.transparentVertexBuffer;
+        indices = &m_buffers.transparentIndexBuffer;
+    } else if (pass == Pass::CROSS) {
+        vertices = &m_buffers.crossVertexBuffer;
+        indices = &m_buffers.crossIndexBuffer;
     }
 
     VkDeviceSize offsets[] = {0};
 
-    VkBuffer vertexBuffer = m_crossVertexBuffer.getBuffer();
+    VkBuffer vertexBuffer = vertices->getBuffer();
     vkCmdBindVertexBuffers(
         cmd,
         0,
@@ -284,12 +460,12 @@ void ChunkMesh::drawCross(VkCommandBuffer cmd)
 
     vkCmdBindIndexBuffer(
         cmd,
-        m_crossIndexBuffer.getBuffer(),
+        indices->getBuffer(),
         0,
         VK_INDEX_TYPE_UINT32
     );
 
-    vkCmdDrawIndexed(cmd, m_crossIndices.size(), 1, 0, 0, 0);
+    return true;
 }
 
 const std::array<glm::vec3, 4> ChunkMesh::FACE_NORTH = {
@@ -349,6 +525,7 @@ const std::array<glm::vec3, 4> ChunkMesh::FACE_CROSS_2 = {
 };
 
 void ChunkMesh::addFace(
+    Geometry &geometry,
     const Chunk &chunk,
     const std::array<const Chunk *, 4> &neighbors,
     const glm::vec3 &pos,
@@ -362,14 +539,17 @@ void ChunkMesh::addFace(
     std::vector<u32> *indicesData;
 
     if (wld::BlockRegistry::get().getBlock(block).transparency) {
-        verticesData = &m_transparentVertices;
-        indicesData = &m_transparentIndices;
-    } else if (wld::BlockRegistry::get().getBlock(block).cross) {
-        verticesData = &m_crossVertices;
-        indicesData = &m_crossIndices;
+        verticesData = &geometry.transparentVertices;
+        indicesData = &geometry.transparentIndices;
+    } else if (
+        wld::BlockRegistry::get().getBlock(block).cross ||
+        wld::BlockRegistry::get().getBlock(block).cutout
+    ) {
+        verticesData = &geometry.crossVertices;
+        indicesData = &geometry.crossIndices;
     } else {
-        verticesData = &m_vertices;
-        indicesData = &m_indices;
+        verticesData = &geometry.vertices;
+        indicesData = &geometry.indices;
     }
 
     u32 indexOffset = verticesData->size();
@@ -388,7 +568,13 @@ void ChunkMesh::addFace(
         adjustWaterHeight = (blockAbove != BlockType::WATER);
         
         if (adjustWaterHeight) {
-            f32 heightScale = 0.875f;
+            u8 level = chunk.getWaterLevel(pos.x, pos.y, pos.z);
+            if (level == Chunk::WATER_FALLING) {
+                level = Chunk::WATER_SOURCE;
+            }
+
+            f32 heightScale = 0.875f * (Chunk::WATER_MAX_LEVEL + 1 - level) /
+                (Chunk::WATER_MAX_LEVEL + 1);
             for (int i = 0; i < 4; i++) {
                 adjustedVerts[i].y *= heightScale;
             }
@@ -423,6 +609,9 @@ void ChunkMesh::addFace(
         vertex.lightLevel = faceLightLevel;
         vertex.faceDirection = static_cast<u32>(face);
         verticesData->push_back(vertex);
+
+        geometry.minY = std::min(geometry.minY, vertex.pos.y);
+        geometry.maxY = std::max(geometry.maxY, vertex.pos.y);
     }
 
     indicesData->push_back(indexOffset + 0);
@@ -454,70 +643,6 @@ std::array<glm::vec2, 4> ChunkMesh::getUVs(
     };
 }
 
-bool ChunkMesh::isFaceVisible(
-    const Chunk &chunk,
-    std::array<const Chunk *, 4> neighbors,
-    int x,
-    int y,
-    int z,
-    BlockType block
-)
-{
-    BlockType adjacentBlock;
-    bool isChunkBoundary = false;
-    
-    if (x < 0) {
-        if (neighbors[0] == nullptr) return true;
-        adjacentBlock = neighbors[0]->getBlock(Chunk::CHUNK_SIZE - 1, y, z);
-        isChunkBoundary = true;
-    } else if (x >= Chunk::CHUNK_SIZE) {
-        if (neighbors[1] == nullptr) return true;
-        adjacentBlock = neighbors[1]->getBlock(0, y, z);
-        isChunkBoundary = true;
-    } else if (z < 0) {
-        if (neighbors[2] == nullptr) return true;
-        adjacentBlock = neighbors[2]->getBlock(x, y, Chunk::CHUNK_SIZE - 1);
-        isChunkBoundary = true;
-    } else if (z >= Chunk::CHUNK_SIZE) {
-        if (neighbors[3] == nullptr) return true;
-        adjacentBlock = neighbors[3]->getBlock(x, y, 0);
-        isChunkBoundary = true;
-    } else if (y < 0 || y >= Chunk::CHUNK_HEIGHT) {
-        return true;
-    } else {
-        adjacentBlock = chunk.getBlock(x, y, z);
-    }
-
-    if (adjacentBlock == BlockType::AIR) {
-        return true;
-    }
-
-    if (wld::BlockRegistry::get().getBlock(adjacentBlock).cross) {
-        return true;
-    }
-
-    Block currentData = wld::BlockRegistry::get().getBlock(block);
-    Block adjacentData = wld::BlockRegistry::get().getBlock(adjacentBlock);
-
-    if (isChunkBoundary && block == adjacentBlock) {
-        return false;
-    }
-
-    if (block == adjacentBlock && currentData.transparency && adjacentData.transparency) {
-        return false;
-    }
-
-    if (currentData.transparency && !adjacentData.transparency) {
-        return false;
-    }
-
-    if (currentData.transparency || adjacentData.transparency) {
-        return true;
-    }
-
-    return false;
-}
-
 glm::vec3 ChunkMesh::getNormalFromFace(std::array<glm::vec3, 4> &face)
 {
     if (face == FACE_TOP) return glm::vec3(0.0f, 1.0f, 0.0f);
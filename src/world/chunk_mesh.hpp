@@ -5,6 +5,7 @@
 
 #include "graphics/device.hpp"
 #include "graphics/buffer.hpp"
+#include "section_connectivity.hpp"
 
 namespace wld
 {
@@ -12,6 +13,7 @@ namespace wld
 // forward declarations
 class World;
 class Chunk;
+class FaceMasks;
 struct ChunkPos;
 
 enum class BlockType;
@@ -75,6 +77,50 @@ public:
         }
     };
 
+    enum class Pass
+    {
+        OPAQUE,
+        TRANSPARENT,
+        CROSS
+    };
+
+    static constexpr u32 PASS_COUNT = 3;
+
+    // index offset of each section's first quad per pass, the block walk
+    // goes bottom-up so a section's quads are contiguous
+    using SectionStarts = std::array<
+        std::array<u32, SectionConnectivity::SECTION_COUNT + 1>,
+        PASS_COUNT
+    >;
+
+    struct IndexRange
+    {
+        u32 first;
+        u32 count;
+    };
+
+    struct Geometry
+    {
+        std::vector<Vertex> vertices;
+        std::vector<u32> indices;
+
+        std::vector<Vertex> transparentVertices;
+        std::vector<u32> transparentIndices;
+
+        std::vector<Vertex> crossVertices;
+        std::vector<u32> crossIndices;
+
+        f32 minY = 0.0f;
+        f32 maxY = 0.0f;
+
+        SectionStarts sectionStarts{};
+        SectionConnectivity connectivity;
+
+        void clear();
+        void markSection(int section);
+        usize getCapacityBytes() const;
+    };
+
     ChunkMesh() = default;
     virtual ~ChunkMesh() = default;
 
@@ -84,40 +130,109 @@ public:
     void init(gfx::Device &device);
     void destroy();
 
-    void generate(
+    void build(
         const Chunk &chunk,
-        const std::array<const Chunk *, 4> &neighbors
+        const std::array<const Chunk *, 4> &neighbors,
+        FaceMasks &masks,
+        Geometry &geometry
     );
 
-    void update(
-        const Chunk &chunk,
-        const std::array<const Chunk *, 4> &neighbors
+    void upload(const Geometry &geometry);
+    bool poll();
+
+    bool hasPendingUpload() const { return m_hasPending; }
+    usize getGpuBytes() const;
+
+    // re-orders the translucent quads back-to-front for a chunk-local
+    // camera position, returns true when a new index buffer was queued
+    bool sortTransparent(const glm::vec3 &cameraPos);
+
+    void draw(
+        VkCommandBuffer cmd,
+        Pass pass,
+        u8 sections = SectionConnectivity::ALL_SECTIONS
     );
+    void drawIndirect(
+        VkCommandBuffer cmd,
+        Pass pass,
+        VkBuffer buffer,
+        VkDeviceSize offset
+    );
+
+    u32 getIndexCount(Pass pass) const;
+    bool isEmpty() const;
+
+    // smallest index range covering every section set in the mask
+    IndexRange getIndexRange(Pass pass, u8 sections) const;
 
-    void drawOpaque(VkCommandBuffer cmd);
-    void drawTransparent(VkCommandBuffer cmd);
-    void drawCross(VkCommandBuffer cmd);
+    bool isConnected(int section, Face from, Face to) const {
+        return m_buffers.connectivity.isConnected(section, from, to);
+    }
+
+    f32 getMinY() const { return m_buffers.minY; }
+    f32 getMaxY() const { return m_buffers.maxY; }
+
+    // occlusion result read back from the GPU, decides whether the chunk
+    // is drawn before or after the Hi-Z test
+    bool isOccluded() const { return m_occluded; }
+    void setOccluded(bool occluded) { m_occluded = occluded; }
 
 private:
     gfx::Device *m_device;
 
-    std::vector<Vertex> m_vertices;
-    std::vector<u32> m_indices;
+    struct Buffers
+    {
+        gfx::Buffer vertexBuffer;
+        gfx::Buffer indexBuffer;
 
-    gfx::Buffer m_vertexBuffer;
-    gfx::Buffer m_indexBuffer;
+        gfx::Buffer transparentVertexBuffer;
+        gfx::Buffer transparentIndexBuffer;
 
-    std::vector<Vertex> m_transparentVertices;
-    std::vector<u32> m_transparentIndices;
+        gfx::Buffer crossVertexBuffer;
+        gfx::Buffer crossIndexBuffer;
+
+        u32 indexCount = 0;
+        u32 transparentIndexCount = 0;
+        u32 crossIndexCount = 0;
+
+        f32 minY = 0.0f;
+        f32 maxY = 0.0f;
+
+        SectionStarts sectionStarts{};
+        SectionConnectivity connectivity;
+
+        usize getSize() const;
+    };
 
-    gfx::Buffer m_transparentVertexBuffer;
-    gfx::Buffer m_transparentIndexBuffer;
+    Buffers m_buffers;
+    Buffers m_pending;
 
-    std::vector<Vertex> m_crossVertices;
-    std::vector<u32> m_crossIndices;
+    bool m_hasPending = false;
+    u64 m_pendingValue = 0;
 
-    gfx::Buffer m_crossVertexBuffer;
-    gfx::Buffer m_crossIndexBuffer;
+    void retire(Buffers &buffers);
+    bool bind(VkCommandBuffer cmd, Pass pass);
+
+    bool m_occluded = false;
+
+    // the order of a distant chunk changes slowly, so the camera has to
+    // move further before it is resorted
+    static constexpr f32 RESORT_DISTANCE = 1.0f;
+    static constexpr f32 RESORT_DISTANCE_SCALE = 1.0f / 16.0f;
+
+    // quad centers of the translucent geometry, in vertex order
+    std::vector<glm::vec3> m_transparentCenters;
+    std::vector<glm::vec3> m_pendingCenters;
+
+    // spare translucent index buffer, sorts are copied into it and then
+    // swapped with the drawn one
+    gfx::Buffer m_sortBuffer;
+    u64 m_sortValue = 0;
+    u64 m_sortFrame = 0;
+    bool m_hasSorted = false;
+
+    glm::vec3 m_sortOrigin = glm::vec3(0.0f);
+    bool m_sortDirty = false;
 
     // mesh generation
     static const std::array<glm::vec3, 4> FACE_NORTH;
@@ -130,6 +245,7 @@ private:
     static const std::array<glm::vec3, 4> FACE_CROSS_2;
 
     void addFace(
+        Geometry &geometry,
         const Chunk &chunk,
         const std::array<const Chunk *, 4> &neighbors,
         const glm::vec3 &pos,
@@ -144,15 +260,6 @@ private:
         Face face
     );
 
-    bool isFaceVisible(
-        const Chunk &chunk,
-        std::array<const Chunk *, 4> neighbors,
-        int x,
-        int y,
-        int z,
-        BlockType block
-    );
-
     glm::vec3 getNormalFromFace(std::array<glm::vec3, 4> &face);
     u8 getFaceLightLevel(
         const Chunk &chunk,
@@ -0,0 +1,86 @@
+#include "chunk_scheduler.hpp"
+
+namespace wld
+{
+
+bool ChunkScheduler::Compare::operator()(
+    const ChunkJob &a,
+    const ChunkJob &b
+) const
+{
+    if (a.deadline != b.deadline) {
+        return a.deadline > b.deadline;
+    }
+
+    if (a.deadline != NO_DEADLINE) {
+        return a.sequence > b.sequence;
+    }
+
+    if (a.priority != b.priority) {
+        return a.priority > b.priority;
+    }
+
+    if (a.task != b.task) {
+        return a.task < b.task;
+    }
+
+    return a.sequence > b.sequence;
+}
+
+void ChunkScheduler::push(
+    const ChunkPos &pos,
+    ChunkTask task,
+    f32 priority,
+    u64 deadline
+)
+{
+    u8 &queued = m_queuedPool.acquire(m_queued, pos)->second;
+    u8 bit = taskBit(task);
+
+    if ((queued & bit) && deadline == NO_DEADLINE) {
+        return;
+    }
+
+    queued |= bit;
+
+    m_jobs.push_back({pos, task, priority, deadline, m_sequence++});
+    std::push_heap(m_jobs.begin(), m_jobs.end(), Compare());
+}
+
+void ChunkScheduler::clear()
+{
+    m_jobs.clear();
+    m_queued.clear();
+}
+
+ChunkJob ChunkScheduler::pop()
+{
+    std::pop_heap(m_jobs.begin(), m_jobs.end(), Compare());
+
+    ChunkJob job = m_jobs.back();
+    m_jobs.pop_back();
+
+    return job;
+}
+
+bool ChunkScheduler::take(const ChunkJob &job)
+{
+    auto it = m_queued.find(job.pos);
+    if (it == m_queued.end()) {
+        return false;
+    }
+
+    u8 bit = taskBit(job.task);
+    if (!(it->second & bit)) {
+        return false;
+    }
+
+    it->second &= ~bit;
+    if (it->second == 0) {
+        m_queuedPool.release(m_queued, it);
+    }
+
+    return true;
+}
+
+} // namespace wld
\ No newline at end of file
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <vector>
+#include <chrono>
+#include <limits>
+#include <algorithm>
+#include <unordered_map>
+
+#include "chunk.hpp"
+#include "core/memory/node_pool.hpp"
+
+namespace wld
+{
+
+enum class ChunkTask : u8
+{
+    GENERATE,
+    LIGHT,
+    MESH,
+    UPLOAD
+};
+
+struct ChunkJob
+{
+    ChunkPos pos;
+    ChunkTask task;
+    f32 priority;
+    u64 deadline;
+    u64 sequence;
+};
+
+class ChunkScheduler
+{
+
+public:
+    static constexpr u64 NO_DEADLINE = std::numeric_limits<u64>::max();
+
+    void push(
+        const ChunkPos &pos,
+        ChunkTask task,
+        f32 priority,
+        u64 deadline = NO_DEADLINE
+    );
+
+    template<typename Fn>
+    usize run(f32 budget, Fn &&execute);
+
+    template<typename Fn>
+    usize runDue(Fn &&execute);
+
+    template<typename Fn>
+    void reprioritize(Fn &&priority);
+
+    void clear();
+
+    usize size() const { return m_jobs.size(); }
+    u64 getTick() const { return m_tick; }
+
+private:
+    struct Compare
+    {
+        bool operator()(const ChunkJob &a, const ChunkJob &b) const;
+    };
+
+    std::vector<ChunkJob> m_jobs;
+    using QueuedMap = std::unordered_map<ChunkPos, u8, ChunkPosHash>;
+
+    QueuedMap m_queued;
+    core::NodePool<QueuedMap> m_queuedPool;
+
+    u64 m_tick = 0;
+    u64 m_sequence = 0;
+
+    ChunkJob pop();
+    bool take(const ChunkJob &job);
+
+    static u8 taskBit(ChunkTask task) {
+        return static_cast<u8>(1u << static_cast<u8>(task));
+    }
+};
+
+template<typename Fn>
+usize ChunkScheduler::run(f32 budget, Fn &&execute)
+{
+    m_tick++;
+
+    auto start = std::chrono::steady_clock::now();
+    usize executed = 0;
+
+    while (!m_jobs.empty()) {
+        bool due = m_jobs.front().deadline <= m_tick;
+
+        if (!due && executed > 0) {
+            std::chrono::duration<f32> elapsed =
+                std::chrono::steady_clock::now() - start;
+
+            if (elapsed.count() >= budget) {
+                break;
+            }
+        }
+
+        ChunkJob job = pop();
+        if (take(job) && execute(job)) {
+            executed++;
+        }
+    }
+
+    return executed;
+}
+
+template<typename Fn>
+usize ChunkScheduler::runDue(Fn &&execute)
+{
+    usize executed = 0;
+
+    while (!m_jobs.empty() && m_jobs.front().deadline <= m_tick) {
+        ChunkJob job = pop();
+        if (take(job) && execute(job)) {
+            executed++;
+        }
+    }
+
+    return executed;
+}
+
+template<typename Fn>
+void ChunkScheduler::reprioritize(Fn &&priority)
+{
+    for (auto &job : m_jobs) {
+        if (job.deadline == NO_DEADLINE) {
+            job.priority = priority(job.pos);
+        }
+    }
+
+    std::make_heap(m_jobs.begin(), m_jobs.end(), Compare());
+}
+
+} // namespace wld
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include "edit_batch.hpp"
+
+namespace wld
+{
+
+void EditBatch::set(const glm::ivec3 &pos, BlockType type, u8 level)
+{
+    record(pos, type, false, BlockType::AIR, level);
+}
+
+void EditBatch::setMany(
+    const std::vector<glm::ivec3> &positions,
+    BlockType type,
+    u8 level
+)
+{
+    for (const auto &pos : positions) {
+        record(pos, type, false, BlockType::AIR, level);
+    }
+}
+
+void EditBatch::fill(
+    const glm::ivec3 &min,
+    const glm::ivec3 &max,
+    BlockType type,
+    u8 level
+)
+{
+    for (int y = min.y; y <= max.y; y++) {
+        for (int z = min.z; z <= max.z; z++) {
+            for (int x = min.x; x <= max.x; x++) {
+                record({x, y, z}, type, false, BlockType::AIR, level);
+            }
+        }
+    }
+}
+
+void EditBatch::replace(
+    const glm::ivec3 &min,
+    const glm::ivec3 &max,
+    BlockType from,
+    BlockType to,
+    u8 level
+)
+{
+    for (int y = min.y; y <= max.y; y++) {
+        for (int z = min.z; z <= max.z; z++) {
+            for (int x = min.x; x <= max.x; x++) {
+                record({x, y, z}, to, true, from, level);
+            }
+        }
+    }
+}
+
+void EditBatch::paste(const Region &region, const glm::ivec3 &origin, bool skipAir)
+{
+    for (int y = 0; y < region.size.y; y++) {
+        for (int z = 0; z < region.size.z; z++) {
+            for (int x = 0; x < region.size.x; x++) {
+                BlockType type = region.getBlock(x, y, z);
+
+                if (skipAir && type == BlockType::AIR) {
+                    continue;
+                }
+
+                record(
+                    origin + glm::ivec3(x, y, z),
+                    type,
+                    false,
+                    BlockType::AIR,
+                    region.getLevel(x, y, z)
+                );
+            }
+        }
+    }
+}
+
+void EditBatch::clear()
+{
+    m_edits.clear();
+    m_size = 0;
+}
+
+void EditBatch::record(
+    const glm::ivec3 &pos,
+    BlockType type,
+    bool replace,
+    BlockType match,
+    u8 level
+)
+{
+    if (pos.y < 0 || pos.y >= Chunk::CHUNK_HEIGHT) {
+        return;
+    }
+
+    ChunkPos chunkPos = {
+        (pos.x < 0) ? (pos.x - (Chunk::CHUNK_SIZE - 1)) / Chunk::CHUNK_SIZE : pos.x / Chunk::CHUNK_SIZE,
+        (pos.z < 0) ? (pos.z - (Chunk::CHUNK_SIZE - 1)) / Chunk::CHUNK_SIZE : pos.z / Chunk::CHUNK_SIZE
+    };
+
+    Edit edit;
+    edit.x = static_cast<u8>(pos.x - chunkPos.x * Chunk::CHUNK_SIZE);
+    edit.y = static_cast<u8>(pos.y);
+    edit.z = static_cast<u8>(pos.z - chunkPos.z * Chunk::CHUNK_SIZE);
+    edit.replace = replace;
+    edit.type = type;
+    edit.match = match;
+    edit.level = level;
+
+    m_edits[chunkPos].push_back(edit);
+    m_size++;
+}
+
+} // namespace wld
\ No newline at end of file
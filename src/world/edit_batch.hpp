@@ -0,0 +1,97 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+
+#include "chunk.hpp"
+
+namespace wld
+{
+
+// blocks and their water levels copied out of the world, x fastest then
+// z then y
+struct Region
+{
+    glm::ivec3 size = {0, 0, 0};
+    std::vector<BlockType> blocks;
+    std::vector<u8> levels;
+
+    int getIndex(int x, int y, int z) const {
+        return (y * size.z + z) * size.x + x;
+    }
+
+    BlockType getBlock(int x, int y, int z) const {
+        return blocks[getIndex(x, y, z)];
+    }
+
+    u8 getLevel(int x, int y, int z) const {
+        return levels[getIndex(x, y, z)];
+    }
+};
+
+// records block edits grouped by chunk; World::commit applies them and
+// relights and remeshes every touched chunk once, however many blocks
+// changed in it
+class EditBatch
+{
+
+public:
+    struct Edit
+    {
+        u8 x, y, z;
+        bool replace;
+        BlockType type;
+        BlockType match;
+        u8 level;
+    };
+
+    using ChunkEdits = std::unordered_map<ChunkPos,
+        std::vector<Edit>,
+        ChunkPosHash>;
+
+    // level is the water level of the block, see Chunk::WATER_SOURCE
+    void set(const glm::ivec3 &pos, BlockType type, u8 level = 0);
+    void setMany(
+        const std::vector<glm::ivec3> &positions,
+        BlockType type,
+        u8 level = 0
+    );
+
+    // bounds are inclusive
+    void fill(
+        const glm::ivec3 &min,
+        const glm::ivec3 &max,
+        BlockType type,
+        u8 level = 0
+    );
+    void replace(
+        const glm::ivec3 &min,
+        const glm::ivec3 &max,
+        BlockType from,
+        BlockType to,
+        u8 level = 0
+    );
+
+    void paste(const Region &region, const glm::ivec3 &origin, bool skipAir = false);
+
+    void clear();
+
+    bool empty() const { return m_size == 0; }
+    usize size() const { return m_size; }
+
+    const ChunkEdits &getEdits() const { return m_edits; }
+
+private:
+    void record(
+        const glm::ivec3 &pos,
+        BlockType type,
+        bool replace = false,
+        BlockType match = BlockType::AIR,
+        u8 level = 0
+    );
+
+    ChunkEdits m_edits;
+    usize m_size = 0;
+};
+
+} // namespace wld
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include "face_masks.hpp"
+#include "block_registry.hpp"
+
+namespace wld
+{
+
+namespace
+{
+
+BlockType getPaddedBlock(
+    const Chunk &chunk,
+    const std::array<const Chunk *, 4> &neighbors,
+    int x,
+    int y,
+    int z
+)
+{
+    constexpr int last = Chunk::CHUNK_SIZE - 1;
+
+    // a missing neighbour shows its faces the same way air does
+    if (y < 0 || y >= Chunk::CHUNK_HEIGHT) {
+        return BlockType::AIR;
+    }
+
+    if (x < 0) {
+        return neighbors[0] ? neighbors[0]->getBlock(last, y, z) : BlockType::AIR;
+    } else if (x > last) {
+        return neighbors[1] ? neighbors[1]->getBlock(0, y, z) : BlockType::AIR;
+    } else if (z < 0) {
+        return neighbors[2] ? neighbors[2]->getBlock(x, y, last) : BlockType::AIR;
+    } else if (z > last) {
+        return neighbors[3] ? neighbors[3]->getBlock(x, y, 0) : BlockType::AIR;
+    }
+
+    return chunk.getBlock(x, y, z);
+}
+
+} // namespace
+
+void FaceMasks::build(
+    const Chunk &chunk,
+    const std::array<const Chunk *, 4> &neighbors
+)
+{
+    const auto &registry = BlockRegistry::get();
+
+    m_translucentCount = 0;
+
+    for (int y = -1; y <= Chunk::CHUNK_HEIGHT; y++) {
+        for (int z = -1; z <= Chunk::CHUNK_SIZE; z++) {
+            const int row = getRow(y, z);
+            const bool edgeZ = z < 0 || z >= Chunk::CHUNK_SIZE;
+
+            u32 solid = 0;
+            u32 clear = 0;
+            u32 cross = 0;
+
+            for (int x = -1; x <= Chunk::CHUNK_SIZE; x++) {
+                const u32 bit = 1u << (x + 1);
+                const bool edgeX = x < 0 || x >= Chunk::CHUNK_SIZE;
+
+                // corners are never a face neighbour
+                if (edgeX && edgeZ) {
+                    clear |= bit;
+                    continue;
+                }
+
+                BlockType type = getPaddedBlock(chunk, neighbors, x, y, z);
+                if (type == BlockType::AIR) {
+                    clear |= bit;
+                    continue;
+                }
+
+                const Block &block = registry.getBlock(type);
+
+                if (block.cross) {
+                    clear |= bit;
+                    cross |= bit;
+                } else if (block.transparency) {
+                    solid |= bit;
+                    clear |= bit;
+                    getTypeRows(type)[row] |= bit;
+                } else {
+                    solid |= bit;
+                }
+            }
+
+            m_solid[row] = solid;
+            m_clear[row] = clear;
+            m_cross[row] = cross;
+        }
+    }
+}
+
+u32 FaceMasks::getFaces(int y, int z, Face face) const
+{
+    const int row = getRow(y, z);
+
+    int neighbor = row;
+    int shift = 0;
+
+    switch (face)
+    {
+
+    case Face::WEST:
+        shift = 1;
+        break;
+
+    case Face::EAST:
+        shift = -1;
+        break;
+
+    case Face::BOTTOM:
+        neighbor = getRow(y - 1, z);
+        break;
+
+    case Face::TOP:
+        neighbor = getRow(y + 1, z);
+        break;
+
+    case Face::NORTH:
+        neighbor = getRow(y, z + 1);
+        break;
+
+    case Face::SOUTH:
+        neighbor = getRow(y, z - 1);
+        break;
+    }
+
+    auto align = [shift](u32 bits) {
+        return shift > 0 ? bits << 1 : shift < 0 ? bits >> 1 : bits;
+    };
+
+    u32 faces = m_solid[row] & align(m_clear[neighbor]);
+
+    for (usize i = 0; i < m_translucentCount; i++) {
+        const Rows &rows = m_translucent[i].rows;
+        faces &= ~(rows[row] & align(rows[neighbor]));
+    }
+
+    return (faces >> 1) & CHUNK_BITS;
+}
+
+FaceMasks::Rows &FaceMasks::getTypeRows(BlockType type)
+{
+    for (usize i = 0; i < m_translucentCount; i++) {
+        if (m_translucent[i].type == type) {
+            return m_translucent[i].rows;
+        }
+    }
+
+    if (m_translucentCount == m_translucent.size()) {
+        m_translucent.emplace_back();
+    }
+
+    TypeRows &entry = m_translucent[m_translucentCount++];
+    entry.type = type;
+    entry.rows.fill(0);
+
+    return entry.rows;
+}
+
+} // namespace wld
\ No newline at end of file
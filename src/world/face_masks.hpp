@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "chunk.hpp"
+
+namespace wld
+{
+
+// per-row bitmasks over a copy of the chunk padded by one block on every
+// side, bit x of a row is the block at x - 1; visible faces fall out of
+// shifting the neighbouring rows against the solid blocks of a row
+class FaceMasks
+{
+
+public:
+    static constexpr int PADDED_SIZE = Chunk::CHUNK_SIZE + 2;
+    static constexpr int PADDED_HEIGHT = Chunk::CHUNK_HEIGHT + 2;
+
+    void build(const Chunk &chunk, const std::array<const Chunk *, 4> &neighbors);
+
+    // bit x is set when the block at (x, y, z) shows the given face
+    u32 getFaces(int y, int z, Face face) const;
+    u32 getCross(int y, int z) const {
+        return (m_cross[getRow(y, z)] >> 1) & CHUNK_BITS;
+    }
+
+    // index of the lowest set bit, which is then cleared
+    static u32 popLowest(u32 &bits)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, bits);
+#else
+        u32 index = static_cast<u32>(__builtin_ctz(bits));
+#endif
+        bits &= bits - 1;
+        return static_cast<u32>(index);
+    }
+
+private:
+    static constexpr int ROW_COUNT = PADDED_HEIGHT * PADDED_SIZE;
+    static constexpr u32 CHUNK_BITS = (1u << Chunk::CHUNK_SIZE) - 1;
+
+    using Rows = std::array<u32, ROW_COUNT>;
+
+    struct TypeRows
+    {
+        BlockType type;
+        Rows rows;
+    };
+
+    // blocks that own faces, blocks that let a neighbour's face show and
+    // cross-shaped plants, which are meshed separately
+    Rows m_solid;
+    Rows m_clear;
+    Rows m_cross;
+
+    // translucent blocks hide faces only against their own type
+    std::vector<TypeRows> m_translucent;
+    usize m_translucentCount = 0;
+
+    static int getRow(int y, int z) {
+        return (y + 1) * PADDED_SIZE + (z + 1);
+    }
+
+    Rows &getTypeRows(BlockType type);
+};
+
+} // namespace wld
\ No newline at end of file
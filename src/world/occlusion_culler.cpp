@@ -0,0 +1,197 @@
+#include "occlusion_culler.hpp"
+
+namespace wld
+{
+
+void OcclusionCuller::init(gfx::Device &device, u32 capacity)
+{
+    m_device = &device;
+    m_capacity = capacity;
+
+    std::vector<VkDescriptorSetLayoutBinding> bindings = {
+        {
+            0,
+            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+            1,
+            VK_SHADER_STAGE_COMPUTE_BIT,
+            nullptr
+        },
+        {
+            1,
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            1,
+            VK_SHADER_STAGE_COMPUTE_BIT,
+            nullptr
+        },
+        {
+            2,
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            1,
+            VK_SHADER_STAGE_COMPUTE_BIT,
+            nullptr
+        },
+        {
+            3,
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            1,
+            VK_SHADER_STAGE_COMPUTE_BIT,
+            nullptr
+        }
+    };
+
+    m_pipeline.init(
+        device,
+        "chunk_cull.comp.spv",
+        bindings,
+        sizeof(PushConstants)
+    );
+
+    for (auto &frame : m_frames) {
+        frame.bounds = device.createBuffer(
+            sizeof(Bounds) * capacity,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VMA_MEMORY_USAGE_CPU_TO_GPU
+        );
+
+        frame.draws = device.createBuffer(
+            sizeof(VkDrawIndexedIndirectCommand) * DRAWS_PER_CHUNK * capacity,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+            VMA_MEMORY_USAGE_CPU_TO_GPU
+        );
+
+        frame.visibility = device.createBuffer(
+            sizeof(u32) * capacity,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VMA_MEMORY_USAGE_GPU_TO_CPU
+        );
+
+        std::memset(frame.visibility.map(), 0, sizeof(u32) * capacity);
+
+        frame.set = m_pipeline.allocateSet();
+    }
+}
+
+void OcclusionCuller::destroy()
+{
+    for (auto &frame : m_frames) {
+        frame.bounds.destroy();
+        frame.draws.destroy();
+        frame.visibility.destroy();
+    }
+
+    m_pipeline.destroy();
+}
+
+void OcclusionCuller::beginFrame()
+{
+    m_frame = m_device->getCurrentFrame();
+
+    auto &frame = m_frames[m_frame];
+
+    vmaInvalidateAllocation(
+        m_device->getAllocator(),
+        frame.visibility.getAllocation(),
+        0,
+        VK_WHOLE_SIZE
+    );
+
+    m_bounds = static_cast<Bounds *>(frame.bounds.map());
+    m_draws = static_cast<VkDrawIndexedIndirectCommand *>(frame.draws.map());
+    m_visibility = static_cast<const u32 *>(frame.visibility.map());
+}
+
+void OcclusionCuller::dispatch(
+    VkCommandBuffer cmd,
+    const gfx::HiZBuffer &hiz,
+    const glm::mat4 &viewProj,
+    u32 count
+)
+{
+    auto &frame = m_frames[m_frame];
+
+    vmaFlushAllocation(
+        m_device->getAllocator(),
+        frame.bounds.getAllocation(),
+        0,
+        VK_WHOLE_SIZE
+    );
+
+    vmaFlushAllocation(
+        m_device->getAllocator(),
+        frame.draws.getAllocation(),
+        0,
+        VK_WHOLE_SIZE
+    );
+
+    if (count == 0) {
+        return;
+    }
+
+    // the pyramid is recreated on resize, so the set is rewritten each
+    // frame, this frame's previous submission has already completed
+    VkDescriptorImageInfo hizInfo{};
+    hizInfo.sampler = hiz.getSampler();
+    hizInfo.imageView = hiz.getImageView();
+    hizInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+    std::array<VkDescriptorBufferInfo, 3> bufferInfos = {{
+        {frame.bounds.getBuffer(), 0, VK_WHOLE_SIZE},
+        {frame.draws.getBuffer(), 0, VK_WHOLE_SIZE},
+        {frame.visibility.getBuffer(), 0, VK_WHOLE_SIZE}
+    }};
+
+    std::array<VkWriteDescriptorSet, 4> writes{};
+
+    for (u32 i = 0; i < writes.size(); i++) {
+        writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[i].dstSet = frame.set;
+        writes[i].dstBinding = i;
+        writes[i].descriptorCount = 1;
+
+        if (i == 0) {
+            writes[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            writes[i].pImageInfo = &hizInfo;
+        } else {
+            writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[i].pBufferInfo = &bufferInfos[i - 1];
+        }
+    }
+
+    vkUpdateDescriptorSets(
+        m_device->getDevice(),
+        static_cast<u32>(writes.size()),
+        writes.data(),
+        0,
+        nullptr
+    );
+
+    PushConstants pc = {
+        .viewProj = viewProj,
+        .hizSize = glm::vec2(hiz.getWidth(), hiz.getHeight()),
+        .count = count,
+        .hizLevels = hiz.getLevels()
+    };
+
+    m_pipeline.bind(cmd, frame.set);
+    m_pipeline.push(cmd, pc);
+    m_pipeline.dispatch(cmd, (count + GROUP_SIZE - 1) / GROUP_SIZE);
+
+    VkMemoryBarrier2 barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    barrier.srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    barrier.dstStageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT |
+        VK_PIPELINE_STAGE_2_HOST_BIT;
+    barrier.dstAccessMask = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT |
+        VK_ACCESS_2_HOST_READ_BIT;
+
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.memoryBarrierCount = 1;
+    dependencyInfo.pMemoryBarriers = &barrier;
+
+    vkCmdPipelineBarrier2(cmd, &dependencyInfo);
+}
+
+} // namespace wld
\ No newline at end of file
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <vector>
+
+#include "graphics/device.hpp"
+#include "graphics/buffer.hpp"
+#include "graphics/compute_pipeline.hpp"
+#include "graphics/hiz_buffer.hpp"
+
+namespace wld
+{
+
+// second phase of two-phase occlusion culling: chunks drawn in the first
+// phase came from last frame's visibility, everything in the draw list is
+// then tested against a Hi-Z pyramid of that depth on the GPU, which fills
+// in the instance counts of per-chunk indirect draws
+class OcclusionCuller
+{
+
+public:
+    struct Bounds
+    {
+        glm::vec3 min;
+        u32 drawn;
+        glm::vec3 max;
+        u32 padding;
+    };
+
+    enum DrawSlot
+    {
+        D_OPAQUE_LATE,
+        D_CUTOUT,
+        D_TRANSPARENT,
+        DRAWS_PER_CHUNK
+    };
+
+    void init(gfx::Device &device, u32 capacity);
+    void destroy();
+
+    // maps the current frame's buffers, the visibility written the last
+    // time they were culled is readable until dispatch
+    void beginFrame();
+
+    void dispatch(
+        VkCommandBuffer cmd,
+        const gfx::HiZBuffer &hiz,
+        const glm::mat4 &viewProj,
+        u32 count
+    );
+
+public:
+    u32 getCapacity() const { return m_capacity; }
+
+    const u32 *getVisibility() const { return m_visibility; }
+    Bounds *getBounds() { return m_bounds; }
+    VkDrawIndexedIndirectCommand *getDraws() { return m_draws; }
+
+    VkBuffer getDrawBuffer() const {
+        return m_frames[m_frame].draws.getBuffer();
+    }
+
+    static VkDeviceSize getDrawOffset(u32 index, DrawSlot slot)
+    {
+        return (static_cast<VkDeviceSize>(index) * DRAWS_PER_CHUNK + slot) *
+            sizeof(VkDrawIndexedIndirectCommand);
+    }
+
+private:
+    gfx::Device *m_device = nullptr;
+
+    gfx::ComputePipeline m_pipeline;
+
+    struct FrameData
+    {
+        gfx::Buffer bounds;
+        gfx::Buffer draws;
+        gfx::Buffer visibility;
+        VkDescriptorSet set = VK_NULL_HANDLE;
+    };
+
+    std::array<FrameData, gfx::MAX_FRAMES_IN_FLIGHT> m_frames;
+    u32 m_frame = 0;
+    u32 m_capacity = 0;
+
+    Bounds *m_bounds = nullptr;
+    VkDrawIndexedIndirectCommand *m_draws = nullptr;
+    const u32 *m_visibility = nullptr;
+
+    static constexpr u32 GROUP_SIZE = 64;
+
+    struct PushConstants
+    {
+        alignas(16) glm::mat4 viewProj;
+        alignas(8) glm::vec2 hizSize;
+        alignas(4) u32 count;
+        alignas(4) u32 hizLevels;
+    };
+};
+
+} // namespace wld
\ No newline at end of file
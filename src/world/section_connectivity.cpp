@@ -0,0 +1,227 @@
+#include "section_connectivity.hpp"
+#include "chunk.hpp"
+#include "chunk_mesh.hpp"
+#include "block_registry.hpp"
+
+#include <bitset>
+
+namespace wld
+{
+
+static_assert(
+    SectionConnectivity::SECTION_SIZE * SectionConnectivity::SECTION_COUNT ==
+        Chunk::CHUNK_HEIGHT,
+    "sections must tile the chunk height"
+);
+
+namespace
+{
+
+bool isOpaque(BlockType type)
+{
+    if (type == BlockType::AIR) {
+        return false;
+    }
+
+    const Block &block = BlockRegistry::get().getBlock(type);
+    return !block.transparency && !block.cross && !block.cutout;
+}
+
+u8 getBoundaryFaces(int x, int y, int z)
+{
+    constexpr int last = SectionConnectivity::SECTION_SIZE - 1;
+
+    u8 faces = 0;
+
+    if (z == last) faces |= 1 << static_cast<u32>(Face::NORTH);
+    if (z == 0) faces |= 1 << static_cast<u32>(Face::SOUTH);
+    if (x == last) faces |= 1 << static_cast<u32>(Face::EAST);
+    if (x == 0) faces |= 1 << static_cast<u32>(Face::WEST);
+    if (y == last) faces |= 1 << static_cast<u32>(Face::TOP);
+    if (y == 0) faces |= 1 << static_cast<u32>(Face::BOTTOM);
+
+    return faces;
+}
+
+} // namespace
+
+void SectionConnectivity::build(const Chunk &chunk)
+{
+    for (int section = 0; section < SECTION_COUNT; section++) {
+        m_connections[section] = floodSection(chunk, section);
+    }
+}
+
+void SectionConnectivity::connectAll()
+{
+    m_connections.fill(ALL_CONNECTIONS);
+}
+
+bool SectionConnectivity::isConnected(int section, Face from, Face to) const
+{
+    u32 bit = static_cast<u32>(from) * FACE_COUNT + static_cast<u32>(to);
+    return (m_connections[section] >> bit) & 1;
+}
+
+Face SectionConnectivity::getOpposite(Face face)
+{
+    switch (face)
+    {
+
+    case Face::NORTH:
+        return Face::SOUTH;
+
+    case Face::SOUTH:
+        return Face::NORTH;
+
+    case Face::EAST:
+        return Face::WEST;
+
+    case Face::WEST:
+        return Face::EAST;
+
+    case Face::TOP:
+        return Face::BOTTOM;
+
+    case Face::BOTTOM:
+        return Face::TOP;
+    }
+
+    return face;
+}
+
+glm::ivec3 SectionConnectivity::getStep(Face face)
+{
+    switch (face)
+    {
+
+    case Face::NORTH:
+        return {0, 0, 1};
+
+    case Face::SOUTH:
+        return {0, 0, -1};
+
+    case Face::EAST:
+        return {1, 0, 0};
+
+    case Face::WEST:
+        return {-1, 0, 0};
+
+    case Face::TOP:
+        return {0, 1, 0};
+
+    case Face::BOTTOM:
+        return {0, -1, 0};
+    }
+
+    return {0, 0, 0};
+}
+
+int SectionConnectivity::getLowestSection(u8 sections)
+{
+    int section = 0;
+    while (!(sections & (1 << section))) {
+        section++;
+    }
+
+    return section;
+}
+
+int SectionConnectivity::getHighestSection(u8 sections)
+{
+    int section = SECTION_COUNT - 1;
+    while (!(sections & (1 << section))) {
+        section--;
+    }
+
+    return section;
+}
+
+u64 SectionConnectivity::floodSection(const Chunk &chunk, int section) const
+{
+    constexpr int size = SECTION_SIZE;
+
+    auto getCell = [](int x, int y, int z) {
+        return (y * size + z) * size + x;
+    };
+
+    std::bitset<CELL_COUNT> open;
+    std::bitset<CELL_COUNT> visited;
+
+    const int baseY = section * size;
+
+    for (int y = 0; y < size; y++) {
+        for (int z = 0; z < size; z++) {
+            for (int x = 0; x < size; x++) {
+                if (!isOpaque(chunk.getBlock(x, baseY + y, z))) {
+                    open.set(getCell(x, y, z));
+                }
+            }
+        }
+    }
+
+    // a fully open section is the common case above the terrain
+    if (open.all()) {
+        return ALL_CONNECTIONS;
+    }
+
+    std::array<u16, CELL_COUNT> stack;
+    u64 connections = 0;
+
+    for (u32 start = 0; start < CELL_COUNT; start++) {
+        if (!open.test(start) || visited.test(start)) {
+            continue;
+        }
+
+        u8 faces = 0;
+        u32 top = 0;
+
+        stack[top++] = static_cast<u16>(start);
+        visited.set(start);
+
+        while (top > 0) {
+            int cell = stack[--top];
+
+            int x = cell % size;
+            int z = (cell / size) % size;
+            int y = cell / (size * size);
+
+            faces |= getBoundaryFaces(x, y, z);
+
+            for (u32 face = 0; face < FACE_COUNT; face++) {
+                glm::ivec3 next = glm::ivec3(x, y, z) +
+                    getStep(static_cast<Face>(face));
+
+                if (
+                    next.x < 0 || next.x >= size ||
+                    next.y < 0 || next.y >= size ||
+                    next.z < 0 || next.z >= size
+                ) {
+                    continue;
+                }
+
+                int neighbor = getCell(next.x, next.y, next.z);
+                if (open.test(neighbor) && !visited.test(neighbor)) {
+                    visited.set(neighbor);
+                    stack[top++] = static_cast<u16>(neighbor);
+                }
+            }
+        }
+
+        for (u32 from = 0; from < FACE_COUNT; from++) {
+            if (!(faces & (1 << from))) {
+                continue;
+            }
+
+            for (u32 to = 0; to < FACE_COUNT; to++) {
+                if (faces & (1 << to)) {
+                    connections |= 1ull << (from * FACE_COUNT + to);
+                }
+            }
+        }
+    }
+
+    return connections;
+}
+
+} // namespace wld
\ No newline at end of file
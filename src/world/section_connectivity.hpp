@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <glm/glm.hpp>
+
+#include "core/types.hpp"
+
+namespace wld
+{
+
+class Chunk;
+
+enum class Face;
+
+// which faces of each 16^3 section of a chunk can see each other through
+// non-opaque blocks, filled once per mesh build and walked every frame
+class SectionConnectivity
+{
+
+public:
+    static constexpr int SECTION_SIZE = 16;
+    static constexpr int SECTION_COUNT = 8;
+    static constexpr u32 FACE_COUNT = 6;
+    static constexpr u8 ALL_SECTIONS = 0xFF;
+
+    SectionConnectivity() { connectAll(); }
+
+    void build(const Chunk &chunk);
+    void connectAll();
+
+    bool isConnected(int section, Face from, Face to) const;
+
+    static Face getOpposite(Face face);
+    static glm::ivec3 getStep(Face face);
+
+    // expects a non-zero section mask
+    static int getLowestSection(u8 sections);
+    static int getHighestSection(u8 sections);
+
+private:
+    static constexpr u32 CELL_COUNT = SECTION_SIZE * SECTION_SIZE * SECTION_SIZE;
+    static constexpr u64 ALL_CONNECTIONS = (1ull << (FACE_COUNT * FACE_COUNT)) - 1;
+
+    // bit (from * FACE_COUNT + to) per section
+    std::array<u64, SECTION_COUNT> m_connections;
+
+    u64 floodSection(const Chunk &chunk, int section) const;
+};
+
+} // namespace wld
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "streaming_governor.hpp"
+
+namespace wld
+{
+
+void StreamingGovernor::init(i32 renderDistance, f32 tickBudget)
+{
+    m_renderDistance = std::clamp(
+        renderDistance,
+        MIN_RENDER_DISTANCE,
+        MAX_RENDER_DISTANCE
+    );
+
+    m_tickBudget = std::clamp(
+        tickBudget,
+        MIN_TICK_BUDGET,
+        MAX_TICK_BUDGET
+    );
+
+    m_frameTime = 0.0f;
+    m_tickTime = 0.0f;
+    m_tickPeak = 0.0f;
+    m_ticks = 0;
+
+    m_lastPressure = Pressure::STABLE;
+    m_pressureCount = 0;
+}
+
+void StreamingGovernor::reportFrame(f32 frameTime)
+{
+    m_frameTime += (frameTime - m_frameTime) * SMOOTHING;
+}
+
+void StreamingGovernor::reportTick(f32 tickTime, usize backlog)
+{
+    m_tickTime += (tickTime - m_tickTime) * SMOOTHING;
+    m_tickPeak = std::max(m_tickPeak, tickTime);
+
+    if (++m_ticks < TICKS_PER_ADJUST) {
+        return;
+    }
+
+    adjust(backlog);
+
+    m_ticks = 0;
+    m_tickPeak = 0.0f;
+}
+
+void StreamingGovernor::adjust(usize backlog)
+{
+    bool frameOver = m_frameTime > m_targetFrameTime;
+    bool tickOver = m_tickPeak > TICK_PEAK_LIMIT;
+
+    bool frameUnder = m_frameTime < m_targetFrameTime * HEADROOM;
+    bool tickUnder = m_tickPeak < TICK_PEAK_LIMIT * HEADROOM;
+
+    Pressure pressure = Pressure::STABLE;
+    if (frameOver || tickOver) {
+        pressure = Pressure::OVER;
+    } else if (frameUnder && tickUnder) {
+        pressure = Pressure::UNDER;
+    }
+
+    if (pressure == m_lastPressure) {
+        m_pressureCount++;
+    } else {
+        m_lastPressure = pressure;
+        m_pressureCount = 1;
+    }
+
+    switch (pressure)
+    {
+
+    case Pressure::OVER:
+        if (m_tickBudget > MIN_TICK_BUDGET) {
+            m_tickBudget = std::max(m_tickBudget * 0.5f, MIN_TICK_BUDGET);
+        } else if (frameOver && m_renderDistance > MIN_RENDER_DISTANCE) {
+            m_renderDistance--;
+        }
+        m_pressureCount = 0;
+        break;
+
+    case Pressure::UNDER:
+        if (m_pressureCount < STABLE_ADJUSTS) {
+            break;
+        }
+
+        if (backlog > 0 && m_tickBudget < MAX_TICK_BUDGET) {
+            m_tickBudget = std::min(m_tickBudget + BUDGET_STEP, MAX_TICK_BUDGET);
+        } else if (backlog == 0 && m_renderDistance < MAX_RENDER_DISTANCE) {
+            m_renderDistance++;
+        }
+        m_pressureCount = 0;
+        break;
+
+    default:
+        break;
+    }
+}
+
+} // namespace wld
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <algorithm>
+
+#include "core/types.hpp"
+
+namespace wld
+{
+
+class StreamingGovernor
+{
+
+public:
+    void init(i32 renderDistance, f32 tickBudget);
+
+    void reportFrame(f32 frameTime);
+    void reportTick(f32 tickTime, usize backlog);
+
+    void setTargetFrameTime(f32 target) { m_targetFrameTime = target; }
+
+    i32 getRenderDistance() const { return m_renderDistance; }
+    f32 getTickBudget() const { return m_tickBudget; }
+
+    f32 getFrameTime() const { return m_frameTime; }
+    f32 getTickTime() const { return m_tickTime; }
+    f32 getBudgetUsage() const { return m_tickTime / m_targetFrameTime; }
+
+    static constexpr i32 MIN_RENDER_DISTANCE = 4;
+    static constexpr i32 MAX_RENDER_DISTANCE = 16;
+    static constexpr f32 MIN_TICK_BUDGET = 0.0005f;
+    static constexpr f32 MAX_TICK_BUDGET = 0.006f;
+
+private:
+    static constexpr f32 DEFAULT_TARGET_FRAME_TIME = 0.008f;
+    // a tick runs once per 50 ms, so it only has to stay under its own
+    // limit rather than fit in a frame
+    static constexpr f32 TICK_PEAK_LIMIT = MAX_TICK_BUDGET * 2.0f;
+    static constexpr f32 SMOOTHING = 0.1f;
+    static constexpr f32 HEADROOM = 0.75f;
+    static constexpr f32 BUDGET_STEP = 0.0005f;
+    static constexpr u32 TICKS_PER_ADJUST = 20;
+    static constexpr u32 STABLE_ADJUSTS = 3;
+
+    enum class Pressure
+    {
+        OVER,
+        STABLE,
+        UNDER
+    };
+
+    void adjust(usize backlog);
+
+    f32 m_targetFrameTime = DEFAULT_TARGET_FRAME_TIME;
+
+    f32 m_frameTime = 0.0f;
+    f32 m_tickTime = 0.0f;
+    f32 m_tickPeak = 0.0f;
+
+    u32 m_ticks = 0;
+
+    Pressure m_lastPressure = Pressure::STABLE;
+    u32 m_pressureCount = 0;
+
+    i32 m_renderDistance = MIN_RENDER_DISTANCE;
+    f32 m_tickBudget = MIN_TICK_BUDGET;
+};
+
+} // namespace wld
\ No newline at end of file
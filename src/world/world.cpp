@@ -8,6 +8,9 @@ void World::init(gfx::Device &device, gfx::TextureCache &textureCache)
     m_device = &device;
 
     m_playerChunkPos = {-1, -1};
+    m_renderDistance = -1;
+
+    buildOffsets();
 
     m_textureID = textureCache.getTextureID("terrain");
 
@@ -23,6 +26,7 @@ void World::init(gfx::Device &device, gfx::TextureCache &textureCache)
             attributes.size()
         })
         .setPushConstant(sizeof(PushConstants))
+        .setSpecialization(RENDER_MODE_ID, MODE_OPAQUE)
         .setDepthTest(true)
         .setDepthWrite(true)
         .setCull(true)
@@ -37,6 +41,7 @@ void World::init(gfx::Device &device, gfx::TextureCache &textureCache)
             attributes.size()
         })
         .setPushConstant(sizeof(PushConstants))
+        .setSpecialization(RENDER_MODE_ID, MODE_TRANSLUCENT)
         .setCullMode(VK_CULL_MODE_NONE)
         .setBlending(true)
         .setDepthTest(true)
@@ -52,34 +57,104 @@ void World::init(gfx::Device &device, gfx::TextureCache &textureCache)
             attributes.size()
         })
         .setPushConstant(sizeof(PushConstants))
+        .setSpecialization(RENDER_MODE_ID, MODE_CUTOUT)
         .setCullMode(VK_CULL_MODE_NONE)
         .setBlending(false)
         .setDepthTest(true)
         .setDepthWrite(true)
         .build();
 
-    m_chunks.reserve(RENDER_DISTANCE * RENDER_DISTANCE);
-    m_meshes.reserve(RENDER_DISTANCE * RENDER_DISTANCE);
+    m_statistics.init(
+        *m_device,
+        QUERY_COUNT,
+        VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT
+    );
+
+    m_governor.init(RENDER_DISTANCE, TICK_BUDGET);
+
+    const usize maxChunks = (2 * StreamingGovernor::MAX_RENDER_DISTANCE + 1) *
+        (2 * StreamingGovernor::MAX_RENDER_DISTANCE + 1);
+
+    m_hiz.init(*m_device);
+    m_culler.init(*m_device, static_cast<u32>(maxChunks * 2));
+
+    const usize gridCells = SECTION_GRID_SIZE * SECTION_GRID_SIZE;
+
+    m_sectionMasks.resize(gridCells);
+    m_sectionMeshes.resize(gridCells);
+    m_sectionQueue.reserve(gridCells * SectionConnectivity::SECTION_COUNT);
+
+    for (auto &culled : m_culledChunks) {
+        culled.reserve(maxChunks * 2);
+    }
+
+    m_chunks.reserve(maxChunks);
+    m_meshes.reserve(maxChunks);
+    m_chunksNeeded.reserve(maxChunks);
+    m_fillStarts.reserve(maxChunks);
+    m_pendingUploads.reserve(maxChunks);
+
+    const usize maxRing = 2 * StreamingGovernor::MAX_RENDER_DISTANCE + 1;
+
+    m_chunkPool.reserve(maxRing);
+    m_meshPool.reserve(maxRing);
+    m_geometryPool.setLimit(1);
+    m_neededPool.reserve(maxChunks);
+    m_fillPool.reserve(maxChunks);
 
     m_generator.init(0);
 }
 
+void World::setWorkers(core::ThreadPool *workers)
+{
+    m_workers = workers;
+
+    // geometry only lives from meshing to upload, so one spare per thread
+    // is plenty; keeping more would pin the peak capacity of every chunk
+    // that was ever pending
+    m_geometryPool.setLimit(workers ? workers->getThreadCount() + 1 : 1);
+}
+
 void World::destroy()
 {
     for (auto &pipeline : m_pipelines) {
         pipeline.destroy();
     }
 
+    m_statistics.destroy();
+    m_culler.destroy();
+    m_hiz.destroy();
+
     for (auto &[pos, mesh] : m_meshes) {
         mesh->destroy();
     }
 
+    m_scheduler.clear();
+    m_ticker.clear();
+    m_fillStarts.clear();
+    m_pendingUploads.clear();
+
     m_chunks.clear();
     m_meshes.clear();
+    m_geometries.clear();
+
+    m_chunkPool.clear();
+    m_meshPool.clear();
+    m_geometryPool.clear();
+    m_neededPool.clear();
+    m_fillPool.clear();
 }
 
-void World::update(const glm::vec3 &playerPos, f32 dt)
+void World::update(
+    const glm::vec3 &playerPos,
+    const glm::vec3 &playerVelocity,
+    const glm::vec3 &viewDir,
+    f32 dt
+)
 {
+    auto start = std::chrono::steady_clock::now();
+    u64 allocations = core::AllocCounter::getCount();
+
     ChunkPos newPos = {
         static_cast<i32>(playerPos.x) / Chunk::CHUNK_SIZE,
         static_cast<i32>(playerPos.z) / Chunk::CHUNK_SIZE
@@ -90,412 +165,1467 @@ void World::update(const glm::vec3 &playerPos, f32 dt)
 
     if (time >= 1.0f) {
         time = 0.0f;
-        m_updatedChunks = m_pendingChunks.size() + m_pendingMeshes.size();
+        m_updatedChunks = m_meshUpdates;
+        m_meshUpdates = 0;
+
+        updateMemoryStats();
     }
-    
-    const f32 squaredDist = RENDER_DISTANCE * RENDER_DISTANCE;
 
-    m_chunksNeeded.clear();
-    m_chunksToLoad.clear();
-    m_chunksToUnload.clear();
+    glm::vec2 flatDir(viewDir.x, viewDir.z);
+    if (glm::length(flatDir) > 0.0f) {
+        flatDir = glm::normalize(flatDir);
+    }
 
-    if (newPos != m_playerChunkPos || m_pendingChunks.empty()) {
-        std::queue<ChunkPos> empty;
-        std::swap(m_pendingChunks, empty);
-        std::swap(m_pendingMeshes, empty);
+    const i32 renderDistance = m_governor.getRenderDistance();
 
-        for (int x = -RENDER_DISTANCE; x <= RENDER_DISTANCE; x++) {
-            for (int z = -RENDER_DISTANCE; z <= RENDER_DISTANCE; z++) {
-                if (x * x + z * z > squaredDist) continue;
+    glm::vec2 lookahead = glm::vec2(playerVelocity.x, playerVelocity.z) *
+        LOOKAHEAD / static_cast<f32>(Chunk::CHUNK_SIZE);
 
-                ChunkPos pos = {newPos.x + x, newPos.z + z};
+    f32 maxLookahead = static_cast<f32>(renderDistance);
+    if (glm::length(lookahead) > maxLookahead) {
+        lookahead = glm::normalize(lookahead) * maxLookahead;
+    }
 
-                m_chunksNeeded.insert(pos);
+    m_focus = glm::vec2(playerPos.x, playerPos.z) /
+        static_cast<f32>(Chunk::CHUNK_SIZE) + lookahead;
 
-                if (!isChunkLoaded(pos)) {
-                    f32 maxDist = static_cast<f32>(x * x + z * z);
-                    m_chunksToLoad.push_back({pos, maxDist});
-                }
-            }
-        }
+    if (newPos != m_playerChunkPos || renderDistance != m_renderDistance) {
+        m_viewDir = flatDir;
+        m_prioritizedFocus = m_focus;
 
-        std::sort(
-            m_chunksToLoad.begin(),
-            m_chunksToLoad.end(),
-            [](const auto &a, const auto &b) {
-                return a.second < b.second;
-            }
-        );
+        updateStreamingSet(newPos, renderDistance);
 
-        for (const auto &[pos, dist] : m_chunksToLoad) {
-            m_pendingChunks.push(pos);
-        }
+        m_scheduler.reprioritize([this](const ChunkPos &pos) {
+            return getPriority(pos);
+        });
+    } else if (
+        glm::dot(flatDir, m_viewDir) < REPRIORITIZE_DOT ||
+        glm::distance(m_focus, m_prioritizedFocus) > 1.0f
+    ) {
+        m_viewDir = flatDir;
+        m_prioritizedFocus = m_focus;
 
-        for (const auto &[pos, chunk] : m_chunks) {
-            if (m_chunksNeeded.find(pos) == m_chunksNeeded.end()) {
-                m_chunksToUnload.push_back(pos);
-            }
-        }
+        m_scheduler.reprioritize([this](const ChunkPos &pos) {
+            return getPriority(pos);
+        });
+    }
 
-        for (const auto &pos : m_chunksToUnload) {
-            unloadChunks(pos);
-        }
+    m_scheduler.run(m_governor.getTickBudget(), [this](const ChunkJob &job) {
+        return runJob(job);
+    });
 
-        m_playerChunkPos = newPos;
-    }
+    m_device->getUploadManager().submit();
 
-    int chunksLoaded = 0;
-    while (!m_pendingChunks.empty() && chunksLoaded < CHUNKS_PER_TICK) {
-        ChunkPos pos = m_pendingChunks.front();
-        m_pendingChunks.pop();
+    std::chrono::duration<f32> elapsed =
+        std::chrono::steady_clock::now() - start;
 
-        if (
-            !isChunkLoaded(pos) &&
-            m_chunksNeeded.find(pos) != m_chunksNeeded.end()
-        ) {
-            loadChunks(pos);
-            
-            m_pendingMeshes.push(pos);
-            
-            ChunkPos neighbors[4] = {
-                {pos.x - 1, pos.z},
-                {pos.x + 1, pos.z},
-                {pos.x, pos.z - 1},
-                {pos.x, pos.z + 1}
-            };
-            
-            for (const auto& neighborPos : neighbors) {
-                if (
-                    isChunkLoaded(neighborPos)
-                    && m_chunksNeeded.find(neighborPos) != m_chunksNeeded.end()
-                ) {
-                    m_pendingMeshes.push(neighborPos);
-                }
-            }
-            
-            chunksLoaded++;
-        }
-    }
+    m_governor.reportTick(elapsed.count(), m_scheduler.size());
+
+    m_tickAllocations = core::AllocCounter::getCount() - allocations;
+}
+
+void World::prepareRender(const core::Camera &camera)
+{
+    pollUploads();
+
+    m_statistics.beginFrame();
+    m_culler.beginFrame();
+
+    // visibility the GPU wrote the last time this frame's buffers were used
+    const u32 frame = m_device->getCurrentFrame();
+    const u32 *visibility = m_culler.getVisibility();
+    auto &culled = m_culledChunks[frame];
 
-    while (!m_pendingMeshes.empty()) {
-        ChunkPos pos = m_pendingMeshes.front();
-        m_pendingMeshes.pop();
+    for (usize i = 0; i < culled.size(); i++) {
+        auto it = m_meshes.find(culled[i]);
 
-        if (isChunkLoaded(pos)) {
-            updateMeshe(pos);
+        if (it != m_meshes.end()) {
+            it->second->setOccluded(visibility[i] == 0);
         }
     }
-}
 
-void World::render(const core::Camera &camera, VkCommandBuffer cmd)
-{
+    m_viewProj = camera.getProj() * camera.getView();
     m_frustum = core::Frustum::fromViewProj(
         camera.getView(),
         camera.getProj()
     );
 
-    m_pipelines[P_OPAQUE].bind(cmd);
+    m_visible.clear();
 
-    for (const auto &[pos, mesh] : m_meshes) {
-        f32 x = static_cast<f32>(pos.x * Chunk::CHUNK_SIZE);
-        f32 z = static_cast<f32>(pos.z * Chunk::CHUNK_SIZE);
+    const glm::vec3 cameraPos = camera.getPos();
+    bool sorted = false;
 
-        glm::vec3 min(x, 0.0f, z);
-        glm::vec3 max(
-            x + Chunk::CHUNK_SIZE,
-            Chunk::CHUNK_HEIGHT,
-            z + Chunk::CHUNK_SIZE
-        );
+    findVisibleSections(cameraPos);
 
-        if (!m_frustum.isBoxVisible(min, max)) {
+    for (const auto &[pos, mesh] : m_meshes) {
+        if (mesh->isEmpty()) {
             continue;
         }
 
-        PushConstants pc = {
-            .model = glm::translate(glm::mat4(1.0f), {x, 0.0f, z}),
-            .textureID = m_textureID
-        };
-
-        m_pipelines[P_OPAQUE].push(cmd, pc);
-
-        mesh->drawOpaque(cmd);
-    }
-
-    m_pipelines[P_TRANSPARENT].bind(cmd);
+        u8 sections = getVisibleSections(pos);
+        if (sections == 0) {
+            continue;
+        }
 
-    for (const auto &[pos, mesh] : m_meshes) {
         f32 x = static_cast<f32>(pos.x * Chunk::CHUNK_SIZE);
         f32 z = static_cast<f32>(pos.z * Chunk::CHUNK_SIZE);
 
-        glm::vec3 min(x, 0.0f, z);
+        glm::vec3 min(x, mesh->getMinY(), z);
         glm::vec3 max(
             x + Chunk::CHUNK_SIZE,
-            Chunk::CHUNK_HEIGHT,
+            mesh->getMaxY(),
             z + Chunk::CHUNK_SIZE
         );
 
+        const int sectionSize = SectionConnectivity::SECTION_SIZE;
+        int low = SectionConnectivity::getLowestSection(sections);
+        int high = SectionConnectivity::getHighestSection(sections);
+
+        min.y = std::max(min.y, static_cast<f32>(low * sectionSize));
+        max.y = std::min(max.y, static_cast<f32>((high + 1) * sectionSize));
+
+        if (min.y >= max.y) {
+            continue;
+        }
+
         if (!m_frustum.isBoxVisible(min, max)) {
             continue;
         }
 
-        PushConstants pc = {
-            .model = glm::translate(glm::mat4(1.0f), {x, 0.0f, z}),
-            .textureID = m_textureID
-        };
+        glm::vec2 center(
+            x + Chunk::CHUNK_SIZE * 0.5f,
+            z + Chunk::CHUNK_SIZE * 0.5f
+        );
+        glm::vec2 offset = center - glm::vec2(cameraPos.x, cameraPos.z);
+
+        m_visible.push_back({
+            pos,
+            mesh.get(),
+            glm::dot(offset, offset),
+            sections,
+            min.y,
+            max.y
+        });
+
+        glm::vec3 localCamera = cameraPos - glm::vec3(x, 0.0f, z);
+        sorted |= mesh->sortTransparent(localCamera);
+    }
 
-        m_pipelines[P_TRANSPARENT].push(cmd, pc);
+    // opaque and cutout passes walk this front-to-back for early-Z,
+    // the translucent pass walks it back-to-front for blending
+    std::sort(
+        m_visible.begin(),
+        m_visible.end(),
+        [](const VisibleChunk &a, const VisibleChunk &b) {
+            return a.distance < b.distance;
+        }
+    );
 
-        mesh->drawTransparent(cmd);
+    // only while unloading lags behind the streaming radius, drop the
+    // farthest chunks rather than overrun the cull buffers
+    if (m_visible.size() > m_culler.getCapacity()) {
+        m_visible.resize(m_culler.getCapacity());
     }
 
-    m_pipelines[P_CROSS].bind(cmd);
+    auto *bounds = m_culler.getBounds();
+    auto *draws = m_culler.getDraws();
 
-    for (const auto &[pos, mesh] : m_meshes) {
-        f32 x = static_cast<f32>(pos.x * Chunk::CHUNK_SIZE);
-        f32 z = static_cast<f32>(pos.z * Chunk::CHUNK_SIZE);
+    culled.clear();
 
-        glm::vec3 min(x, 0.0f, z);
-        glm::vec3 max(
-            x + Chunk::CHUNK_SIZE,
-            Chunk::CHUNK_HEIGHT,
-            z + Chunk::CHUNK_SIZE
-        );
+    for (u32 i = 0; i < m_visible.size(); i++) {
+        const auto &visible = m_visible[i];
 
-        if (!m_frustum.isBoxVisible(min, max)) {
-            continue;
-        }
+        f32 x = static_cast<f32>(visible.pos.x * Chunk::CHUNK_SIZE);
+        f32 z = static_cast<f32>(visible.pos.z * Chunk::CHUNK_SIZE);
 
-        PushConstants pc = {
-            .model = glm::translate(glm::mat4(1.0f), {x, 0.0f, z}),
-            .textureID = m_textureID
+        bounds[i] = {
+            .min = glm::vec3(x, visible.minY, z),
+            .drawn = visible.mesh->isOccluded() ? 0u : 1u,
+            .max = glm::vec3(
+                x + Chunk::CHUNK_SIZE,
+                visible.maxY,
+                z + Chunk::CHUNK_SIZE
+            ),
+            .padding = 0
         };
 
-        m_pipelines[P_CROSS].push(cmd, pc);
+        auto getDraw = [&](ChunkMesh::Pass pass) {
+            auto range = visible.mesh->getIndexRange(pass, visible.sections);
+            return VkDrawIndexedIndirectCommand{range.count, 0, range.first, 0, 0};
+        };
 
-        mesh->drawCross(cmd);
-    }
-}
+        auto *draw = draws + i * OcclusionCuller::DRAWS_PER_CHUNK;
+        draw[OcclusionCuller::D_OPAQUE_LATE] = getDraw(ChunkMesh::Pass::OPAQUE);
+        draw[OcclusionCuller::D_CUTOUT] = getDraw(ChunkMesh::Pass::CROSS);
+        draw[OcclusionCuller::D_TRANSPARENT] = getDraw(ChunkMesh::Pass::TRANSPARENT);
 
-BlockType World::getBlock(int x, int y, int z) const
-{
-    if (y < 0 || y >= Chunk::CHUNK_HEIGHT) {
-        return BlockType::AIR;
+        culled.push_back(visible.pos);
     }
 
-    ChunkPos chunkPos(
-        (x < 0) ?(x - (Chunk::CHUNK_SIZE - 1)) / Chunk::CHUNK_SIZE :
-            x / Chunk::CHUNK_SIZE,
-        (z < 0) ? (z - (Chunk::CHUNK_SIZE - 1)) / Chunk::CHUNK_SIZE :
-            z / Chunk::CHUNK_SIZE
-    );
-
-    auto it = m_chunks.find(chunkPos);
-    if (it == m_chunks.end()) {
-        return BlockType::AIR;
+    if (sorted) {
+        m_device->getUploadManager().submit();
     }
+}
 
-    int localX = x - (chunkPos.x * Chunk::CHUNK_SIZE);
-    int localZ = z - (chunkPos.z * Chunk::CHUNK_SIZE);
+void World::cull(VkCommandBuffer cmd, const gfx::Image &depth)
+{
+    m_hiz.build(cmd, depth);
 
-    return it->second->getBlock(localX, y, localZ);
+    m_culler.dispatch(
+        cmd,
+        m_hiz,
+        m_viewProj,
+        static_cast<u32>(m_visible.size())
+    );
 }
 
-void World::placeBlock(const glm::ivec3 &pos, BlockType type)
+void World::renderOpaque(VkCommandBuffer cmd)
 {
-    ChunkPos chunkPos = {
-        (pos.x < 0) ? (pos.x - (Chunk::CHUNK_SIZE - 1)) / Chunk::CHUNK_SIZE : pos.x / Chunk::CHUNK_SIZE,
-        (pos.z < 0) ? (pos.z - (Chunk::CHUNK_SIZE - 1)) / Chunk::CHUNK_SIZE : pos.z / Chunk::CHUNK_SIZE
-    };
+    m_pipelines[P_OPAQUE].bind(cmd);
+    m_statistics.begin(cmd, Q_OPAQUE);
 
-    if (auto it = m_chunks.find(chunkPos); it != m_chunks.end()) {
-        glm::ivec3 localPos = {
-            pos.x - (chunkPos.x * Chunk::CHUNK_SIZE),
-            pos.y,
-            pos.z - (chunkPos.z * Chunk::CHUNK_SIZE)
-        };
+    for (const auto &visible : m_visible) {
+        if (visible.mesh->isOccluded()) {
+            continue;
+        }
 
-        it->second->setBlock(localPos, type);
+        pushChunk(cmd, P_OPAQUE, visible);
+        visible.mesh->draw(cmd, ChunkMesh::Pass::OPAQUE, visible.sections);
+    }
 
-        it->second->update();
+    m_statistics.end(cmd, Q_OPAQUE);
+}
 
-        updateMeshe(chunkPos);
+void World::renderOpaqueLate(VkCommandBuffer cmd)
+{
+    drawCulled(
+        cmd,
+        P_OPAQUE,
+        Q_OPAQUE_LATE,
+        ChunkMesh::Pass::OPAQUE,
+        OcclusionCuller::D_OPAQUE_LATE,
+        false
+    );
+}
 
-        if (localPos.x == 0)
-            updateMeshe({chunkPos.x - 1, chunkPos.z});
-        if (localPos.x == Chunk::CHUNK_SIZE - 1)
-            updateMeshe({chunkPos.x + 1, chunkPos.z});
-        if (localPos.z == 0)
-            updateMeshe({chunkPos.x, chunkPos.z - 1});
-        if (localPos.z == Chunk::CHUNK_SIZE - 1)
-            updateMeshe({chunkPos.x, chunkPos.z + 1});
-    }
+void World::renderTransparent(VkCommandBuffer cmd)
+{
+    drawCulled(
+        cmd,
+        P_TRANSPARENT,
+        Q_TRANSPARENT,
+        ChunkMesh::Pass::TRANSPARENT,
+        OcclusionCuller::D_TRANSPARENT,
+        true
+    );
 }
 
-void World::deleteBlock(const glm::ivec3 &pos)
+void World::renderCutout(VkCommandBuffer cmd)
 {
-    placeBlock(pos, BlockType::AIR);
+    drawCulled(
+        cmd,
+        P_CROSS,
+        Q_CUTOUT,
+        ChunkMesh::Pass::CROSS,
+        OcclusionCuller::D_CUTOUT,
+        false
+    );
 }
 
-bool World::raycast(
-    const Ray &ray,
-    f32 maxDistance,
-    RaycastResult &result
+void World::drawCulled(
+    VkCommandBuffer cmd,
+    PipelineType type,
+    Query query,
+    ChunkMesh::Pass pass,
+    OcclusionCuller::DrawSlot slot,
+    bool backToFront
 )
 {
-    glm::vec3 pos = ray.origin;
-    glm::vec3 step = glm::sign(ray.direction);
-    glm::vec3 tDelta = glm::abs(1.0f / ray.direction);
-    glm::vec3 tMax;
-    glm::ivec3 blockPos = glm::floor(pos);
+    m_pipelines[type].bind(cmd);
+    m_statistics.begin(cmd, query);
 
-    for (i32 i = 0; i < 3; i++) {
-        if (step[i] > 0) {
-            tMax[i] = ((blockPos[i] + 1) - pos[i]) * tDelta[i];
-        } else {
-            tMax[i] = (pos[i] - blockPos[i]) * tDelta[i];
+    VkBuffer drawBuffer = m_culler.getDrawBuffer();
+
+    for (usize i = 0; i < m_visible.size(); i++) {
+        u32 index = static_cast<u32>(
+            backToFront ? m_visible.size() - 1 - i : i
+        );
+        const auto &visible = m_visible[index];
+
+        if (visible.mesh->getIndexRange(pass, visible.sections).count == 0) {
+            continue;
         }
+
+        pushChunk(cmd, type, visible);
+        visible.mesh->drawIndirect(
+            cmd,
+            pass,
+            drawBuffer,
+            OcclusionCuller::getDrawOffset(index, slot)
+        );
     }
 
-    Face hitFace;
-    f32 dist = 0.0f;
+    m_statistics.end(cmd, query);
+}
 
-    while (dist < maxDistance) {
-        if (tMax.x < tMax.y && tMax.x < tMax.z) {
-            blockPos.x += step.x;
-            dist = tMax.x;
-            tMax.x += tDelta.x;
-            hitFace = (step.x > 0) ? Face::WEST : Face::EAST;
-        } else if (tMax.y < tMax.z) {
-            blockPos.y += step.y;
-            dist = tMax.y;
-            tMax.y += tDelta.y;
-            hitFace = (step.y > 0) ? Face::BOTTOM : Face::TOP;
-        } else {
-            blockPos.z += step.z;
-            dist = tMax.z;
-            tMax.z += tDelta.z;
-            hitFace = (step.z > 0) ? Face::NORTH : Face::SOUTH;
-        }
+void World::findVisibleSections(const glm::vec3 &cameraPos)
+{
+    const i32 size = Chunk::CHUNK_SIZE;
+    const i32 sectionSize = SectionConnectivity::SECTION_SIZE;
 
-        BlockType type = getBlock(blockPos);
-        if (
-            type != BlockType::AIR &&
-            wld::BlockRegistry::get().getBlock(type).breakable
-        ) {
-            result.pos = blockPos;
-            result.face = hitFace;
+    m_sectionOrigin = {
+        static_cast<i32>(std::floor(cameraPos.x / size)),
+        static_cast<i32>(std::floor(cameraPos.z / size))
+    };
 
-            result.normal = blockPos;
-            switch (hitFace) {
-            case Face::NORTH:
-                result.normal.z--;
-                break;
-            case Face::SOUTH:
-                result.normal.z++;
-                break;
-            case Face::EAST:
-                result.normal.x++;
-                break;
-            case Face::WEST:
-                result.normal.x--;
-                break;
-            case Face::TOP:
-                result.normal.y++;
-                break;
-            case Face::BOTTOM:
-                result.normal.y--;
-                break;
-            }
+    std::fill(m_sectionMasks.begin(), m_sectionMasks.end(), 0);
+    std::fill(m_sectionMeshes.begin(), m_sectionMeshes.end(), nullptr);
 
-            return true;
+    for (const auto &[pos, mesh] : m_meshes) {
+        i32 x = pos.x - m_sectionOrigin.x + SECTION_GRID_RADIUS;
+        i32 z = pos.z - m_sectionOrigin.z + SECTION_GRID_RADIUS;
+
+        if (x >= 0 && x < SECTION_GRID_SIZE && z >= 0 && z < SECTION_GRID_SIZE) {
+            m_sectionMeshes[z * SECTION_GRID_SIZE + x] = mesh.get();
         }
     }
 
-    return false;
-}
+    // a camera above or below the world starts from the nearest section
+    i32 section = std::clamp(
+        static_cast<i32>(std::floor(cameraPos.y / sectionSize)),
+        0,
+        SectionConnectivity::SECTION_COUNT - 1
+    );
 
-bool World::checkCollision(const glm::vec3 &min, const glm::vec3 &max)
-{
-    i32 minX = static_cast<i32>(std::floor(min.x));
-    i32 minY = static_cast<i32>(std::floor(min.y));
-    i32 minZ = static_cast<i32>(std::floor(min.z));
-    i32 maxX = static_cast<i32>(std::floor(max.x));
-    i32 maxY = static_cast<i32>(std::floor(max.y));
-    i32 maxZ = static_cast<i32>(std::floor(max.z));
+    m_sectionQueue.clear();
+    m_sectionQueue.push_back({
+        SECTION_GRID_RADIUS,
+        SECTION_GRID_RADIUS,
+        section,
+        NO_FACE,
+        0
+    });
 
-    minY = std::max(minY, 0);
-    maxY = std::min(maxY, Chunk::CHUNK_HEIGHT - 1);
+    const usize center = SECTION_GRID_RADIUS * SECTION_GRID_SIZE + SECTION_GRID_RADIUS;
+    m_sectionMasks[center] = static_cast<u8>(1 << section);
 
-    ChunkPos currentChunk = {INT_MAX, INT_MAX};
-    const Chunk *chunk = nullptr;
+    for (usize head = 0; head < m_sectionQueue.size(); head++) {
+        const SectionNode node = m_sectionQueue[head];
 
-    for (int x = minX; x <= maxX; ++x) {
-        for (int z = minZ; z <= maxZ; ++z) {
-            ChunkPos chunkPos = {
-                (x < 0) ? (x - (Chunk::CHUNK_SIZE - 1)) / Chunk::CHUNK_SIZE :
-                    x / Chunk::CHUNK_SIZE,
-                (z < 0) ? (z - (Chunk::CHUNK_SIZE - 1)) / Chunk::CHUNK_SIZE :
-                    z / Chunk::CHUNK_SIZE
-            };
+        // chunks without a mesh yet do not block the walk
+        const ChunkMesh *mesh = m_sectionMeshes[node.z * SECTION_GRID_SIZE + node.x];
 
-            if (chunkPos.x != currentChunk.x || chunkPos.z != currentChunk.z) {
-                currentChunk = chunkPos;
-                chunk = getChunk(chunkPos);
+        for (u32 exit = 0; exit < SectionConnectivity::FACE_COUNT; exit++) {
+            Face face = static_cast<Face>(exit);
+            u32 back = static_cast<u32>(SectionConnectivity::getOpposite(face));
 
-                if (!chunk) { continue; }
+            // never step back towards the camera
+            if (node.directions & (1 << back)) {
+                continue;
             }
 
-            i32 localX = x - (chunkPos.x * Chunk::CHUNK_SIZE);
-            i32 localZ = z - (chunkPos.z * Chunk::CHUNK_SIZE);
+            if (
+                node.entry != NO_FACE && mesh &&
+                !mesh->isConnected(node.section, static_cast<Face>(node.entry), face)
+            ) {
+                continue;
+            }
 
-            for (i32 y = minY; y <= maxY; ++y) {
-                BlockType block = chunk->getBlock(localX, y, localZ);
+            glm::ivec3 step = SectionConnectivity::getStep(face);
 
-                if (
-                    chunk &&
-                    block != BlockType::AIR &&
-                    wld::BlockRegistry::get().getBlock(block).collision
-                ) {
-                    return true;
-                }
+            i32 x = node.x + step.x;
+            i32 z = node.z + step.z;
+            i32 next = node.section + step.y;
+
+            if (
+                x < 0 || x >= SECTION_GRID_SIZE ||
+                z < 0 || z >= SECTION_GRID_SIZE ||
+                next < 0 || next >= SectionConnectivity::SECTION_COUNT
+            ) {
+                continue;
+            }
+
+            u8 &mask = m_sectionMasks[z * SECTION_GRID_SIZE + x];
+            if (mask & (1 << next)) {
+                continue;
             }
+
+            glm::vec3 min(
+                static_cast<f32>((m_sectionOrigin.x + x - SECTION_GRID_RADIUS) * size),
+                static_cast<f32>(next * sectionSize),
+                static_cast<f32>((m_sectionOrigin.z + z - SECTION_GRID_RADIUS) * size)
+            );
+            glm::vec3 max = min + glm::vec3(size, sectionSize, size);
+
+            if (!m_frustum.isBoxVisible(min, max)) {
+                continue;
+            }
+
+            mask |= static_cast<u8>(1 << next);
+
+            m_sectionQueue.push_back({
+                x,
+                z,
+                next,
+                back,
+                static_cast<u8>(node.directions | (1 << exit))
+            });
         }
     }
 
-    return false;
+    m_visibleSections = m_sectionQueue.size();
 }
 
-Chunk *World::getChunk(const ChunkPos &pos) const
+u8 World::getVisibleSections(const ChunkPos &pos) const
 {
-    if (auto it = m_chunks.find(pos); it != m_chunks.end()) {
-        return it->second.get();
+    i32 x = pos.x - m_sectionOrigin.x + SECTION_GRID_RADIUS;
+    i32 z = pos.z - m_sectionOrigin.z + SECTION_GRID_RADIUS;
+
+    if (x < 0 || x >= SECTION_GRID_SIZE || z < 0 || z >= SECTION_GRID_SIZE) {
+        return 0;
     }
 
-    return nullptr;
+    return m_sectionMasks[z * SECTION_GRID_SIZE + x];
 }
 
-void World::loadChunks(const ChunkPos &pos)
+void World::pushChunk(
+    VkCommandBuffer cmd,
+    PipelineType type,
+    const VisibleChunk &visible
+)
 {
-    auto chunk = std::make_unique<Chunk>(*this, pos);
+    f32 x = static_cast<f32>(visible.pos.x * Chunk::CHUNK_SIZE);
+    f32 z = static_cast<f32>(visible.pos.z * Chunk::CHUNK_SIZE);
 
-    m_generator.generateChunk(*chunk, pos);
+    // the render distance stays -1 until the first streaming update
+    i32 fogChunks = std::max(m_renderDistance - 1, 0);
 
-    chunk->update();
+    PushConstants pc = {
+        .model = glm::translate(glm::mat4(1.0f), {x, 0.0f, z}),
+        .textureID = m_textureID,
+        .fogEnd = static_cast<f32>(fogChunks * Chunk::CHUNK_SIZE)
+    };
 
-    m_chunks[pos] = std::move(chunk);
+    m_pipelines[type].push(cmd, pc);
 }
 
-void World::unloadChunks(const ChunkPos &pos)
+BlockType World::getBlock(int x, int y, int z) const
 {
-    if (auto it = m_meshes.find(pos); it != m_meshes.end()) {
-        it->second->destroy();
-        m_meshes.erase(it);
+    if (y < 0 || y >= Chunk::CHUNK_HEIGHT) {
+        return BlockType::AIR;
     }
 
-    m_chunks.erase(pos);
-}
-
-bool World::isChunkLoaded(const ChunkPos &pos)
+    ChunkPos chunkPos(
+        (x < 0) ?(x - (Chunk::CHUNK_SIZE - 1)) / Chunk::CHUNK_SIZE :
+            x / Chunk::CHUNK_SIZE,
+        (z < 0) ? (z - (Chunk::CHUNK_SIZE - 1)) / Chunk::CHUNK_SIZE :
+            z / Chunk::CHUNK_SIZE
+    );
+
+    auto it = m_chunks.find(chunkPos);
+    if (it == m_chunks.end()) {
+        return BlockType::AIR;
+    }
+
+    int localX = x - (chunkPos.x * Chunk::CHUNK_SIZE);
+    int localZ = z - (chunkPos.z * Chunk::CHUNK_SIZE);
+
+    return it->second->getBlock(localX, y, localZ);
+}
+
+u8 World::getWaterLevel(const glm::ivec3 &pos) const
+{
+    ChunkPos chunkPos(
+        (pos.x < 0) ? (pos.x - (Chunk::CHUNK_SIZE - 1)) / Chunk::CHUNK_SIZE :
+            pos.x / Chunk::CHUNK_SIZE,
+        (pos.z < 0) ? (pos.z - (Chunk::CHUNK_SIZE - 1)) / Chunk::CHUNK_SIZE :
+            pos.z / Chunk::CHUNK_SIZE
+    );
+
+    auto it = m_chunks.find(chunkPos);
+    if (it == m_chunks.end()) {
+        return 0;
+    }
+
+    return it->second->getWaterLevel(
+        pos.x - (chunkPos.x * Chunk::CHUNK_SIZE),
+        pos.y,
+        pos.z - (chunkPos.z * Chunk::CHUNK_SIZE)
+    );
+}
+
+bool World::hasFlag(const glm::ivec3 &pos, BlockFlag flag) const
+{
+    ChunkPos chunkPos(
+        (pos.x < 0) ? (pos.x - (Chunk::CHUNK_SIZE - 1)) / Chunk::CHUNK_SIZE :
+            pos.x / Chunk::CHUNK_SIZE,
+        (pos.z < 0) ? (pos.z - (Chunk::CHUNK_SIZE - 1)) / Chunk::CHUNK_SIZE :
+            pos.z / Chunk::CHUNK_SIZE
+    );
+
+    auto it = m_chunks.find(chunkPos);
+    if (it == m_chunks.end()) {
+        return false;
+    }
+
+    return it->second->hasFlag(
+        flag,
+        pos.x - (chunkPos.x * Chunk::CHUNK_SIZE),
+        pos.y,
+        pos.z - (chunkPos.z * Chunk::CHUNK_SIZE)
+    );
+}
+
+void World::placeBlock(const glm::ivec3 &pos, BlockType type)
+{
+    EditBatch batch;
+    batch.set(pos, type);
+
+    commit(batch);
+}
+
+usize World::commit(const EditBatch &batch)
+{
+    const u64 deadline = m_scheduler.getTick() + EDIT_DEADLINE;
+    usize touched = 0;
+
+    m_changedBlocks.clear();
+
+    for (const auto &[chunkPos, edits] : batch.getEdits()) {
+        Chunk *chunk = getChunk(chunkPos);
+        if (!chunk) {
+            continue;
+        }
+
+        bool changed = false;
+        bool borders[4] = {false, false, false, false};
+
+        for (const auto &edit : edits) {
+            BlockType current = chunk->getBlock(edit.x, edit.y, edit.z);
+            u8 level = chunk->getWaterLevel(edit.x, edit.y, edit.z);
+
+            if (
+                (current == edit.type && level == edit.level) ||
+                (edit.replace && current != edit.match)
+            ) {
+                continue;
+            }
+
+            chunk->setBlock(edit.x, edit.y, edit.z, edit.type);
+            chunk->setWaterLevel(edit.x, edit.y, edit.z, edit.level);
+            changed = true;
+
+            m_changedBlocks.push_back({
+                chunkPos.x * Chunk::CHUNK_SIZE + edit.x,
+                edit.y,
+                chunkPos.z * Chunk::CHUNK_SIZE + edit.z
+            });
+
+            borders[0] |= edit.x == 0;
+            borders[1] |= edit.x == Chunk::CHUNK_SIZE - 1;
+            borders[2] |= edit.z == 0;
+            borders[3] |= edit.z == Chunk::CHUNK_SIZE - 1;
+        }
+
+        if (!changed) {
+            continue;
+        }
+
+        m_scheduler.push(chunkPos, ChunkTask::LIGHT, 0.0f, deadline);
+        touched++;
+
+        ChunkPos neighbors[4] = {
+            {chunkPos.x - 1, chunkPos.z},
+            {chunkPos.x + 1, chunkPos.z},
+            {chunkPos.x, chunkPos.z - 1},
+            {chunkPos.x, chunkPos.z + 1}
+        };
+
+        for (usize i = 0; i < 4; i++) {
+            if (borders[i] && isChunkLoaded(neighbors[i])) {
+                m_scheduler.push(neighbors[i], ChunkTask::MESH, 0.0f, deadline);
+            }
+        }
+    }
+
+    if (touched == 0) {
+        return 0;
+    }
+
+    for (const auto &pos : m_changedBlocks) {
+        notifyNeighbors(pos);
+    }
+
+    m_scheduler.runDue([this](const ChunkJob &job) {
+        return runJob(job);
+    });
+
+    m_device->getUploadManager().submit();
+
+    return touched;
+}
+
+void World::tickBlocks()
+{
+    auto start = Clock::now();
+
+    m_blockTick++;
+
+    m_dueTicks.clear();
+    m_ticker.advance(m_blockTick, m_dueTicks);
+
+    m_tickEdits.clear();
+    m_waterCells.clear();
+
+    for (const auto &tick : m_dueTicks) {
+        ChunkPos chunkPos = {
+            (tick.pos.x < 0) ? (tick.pos.x - (Chunk::CHUNK_SIZE - 1)) / Chunk::CHUNK_SIZE :
+                tick.pos.x / Chunk::CHUNK_SIZE,
+            (tick.pos.z < 0) ? (tick.pos.z - (Chunk::CHUNK_SIZE - 1)) / Chunk::CHUNK_SIZE :
+                tick.pos.z / Chunk::CHUNK_SIZE
+        };
+
+        if (!getChunk(chunkPos)) {
+            m_ticker.park(chunkPos, tick);
+            continue;
+        }
+
+        if (getBlock(tick.pos) != tick.block) {
+            continue;
+        }
+
+        if (tick.block == BlockType::WATER) {
+            m_waterCells.push_back(tick.pos);
+        } else {
+            runBlockTick(tick, m_tickEdits);
+        }
+    }
+
+    flowWater(m_tickEdits);
+    tickRandomBlocks(m_tickEdits);
+
+    commit(m_tickEdits);
+
+    std::chrono::duration<f32, std::micro> elapsed = Clock::now() - start;
+    m_blockTickTime += (elapsed.count() - m_blockTickTime) * BLOCK_TICK_SMOOTHING;
+}
+
+void World::notifyNeighbors(const glm::ivec3 &pos)
+{
+    static const std::array<glm::ivec3, 7> offsets = {
+        glm::ivec3(0, 0, 0),
+        glm::ivec3(1, 0, 0),
+        glm::ivec3(-1, 0, 0),
+        glm::ivec3(0, 1, 0),
+        glm::ivec3(0, -1, 0),
+        glm::ivec3(0, 0, 1),
+        glm::ivec3(0, 0, -1)
+    };
+
+    const auto &registry = BlockRegistry::get();
+
+    for (const auto &offset : offsets) {
+        glm::ivec3 neighbor = pos + offset;
+        BlockType type = getBlock(neighbor);
+
+        u32 delay = registry.getBlock(type).tickDelay;
+        if (type != BlockType::AIR && delay > 0) {
+            m_ticker.schedule(neighbor, type, m_blockTick + delay);
+        }
+    }
+}
+
+void World::runBlockTick(const ScheduledTick &tick, EditBatch &batch)
+{
+    const Block &block = BlockRegistry::get().getBlock(tick.block);
+
+    if (block.falling) {
+        glm::ivec3 below = tick.pos - glm::ivec3(0, 1, 0);
+
+        if (below.y >= 0 && !hasFlag(below, BlockFlag::COLLIDABLE)) {
+            batch.set(tick.pos, BlockType::AIR);
+            batch.set(below, tick.block);
+        }
+    }
+}
+
+void World::flowWater(EditBatch &batch)
+{
+    m_waterChunks = 0;
+
+    if (m_waterCells.empty()) {
+        return;
+    }
+
+    auto chunkOf = [](const glm::ivec3 &pos) {
+        return ChunkPos(
+            (pos.x < 0) ? (pos.x - (Chunk::CHUNK_SIZE - 1)) / Chunk::CHUNK_SIZE :
+                pos.x / Chunk::CHUNK_SIZE,
+            (pos.z < 0) ? (pos.z - (Chunk::CHUNK_SIZE - 1)) / Chunk::CHUNK_SIZE :
+                pos.z / Chunk::CHUNK_SIZE
+        );
+    };
+
+    std::sort(
+        m_waterCells.begin(),
+        m_waterCells.end(),
+        [&](const glm::ivec3 &a, const glm::ivec3 &b) {
+            ChunkPos chunkA = chunkOf(a);
+            ChunkPos chunkB = chunkOf(b);
+
+            if (chunkA.x != chunkB.x) {
+                return chunkA.x < chunkB.x;
+            }
+
+            if (chunkA.z != chunkB.z) {
+                return chunkA.z < chunkB.z;
+            }
+
+            return std::tie(a.x, a.y, a.z) < std::tie(b.x, b.y, b.z);
+        }
+    );
+
+    m_waterGroups.clear();
+
+    for (usize i = 0; i < m_waterCells.size(); i++) {
+        if (i == 0 || chunkOf(m_waterCells[i]) != chunkOf(m_waterCells[i - 1])) {
+            m_waterGroups.push_back(i);
+        }
+    }
+
+    m_waterChunks = m_waterGroups.size();
+    m_waterGroups.push_back(m_waterCells.size());
+
+    if (m_waterEdits.size() < m_waterChunks) {
+        m_waterEdits.resize(m_waterChunks);
+    }
+
+    auto flowGroups = [this](usize begin, usize end) {
+        for (usize group = begin; group < end; group++) {
+            auto &edits = m_waterEdits[group];
+            edits.clear();
+
+            for (usize i = m_waterGroups[group]; i < m_waterGroups[group + 1]; i++) {
+                flowWaterCell(m_waterCells[i], edits);
+            }
+        }
+    };
+
+    if (m_workers) {
+        m_workers->parallelFor(m_waterChunks, 1, flowGroups);
+    } else {
+        flowGroups(0, m_waterChunks);
+    }
+
+    m_waterMerged.clear();
+
+    for (usize group = 0; group < m_waterChunks; group++) {
+        m_waterMerged.insert(
+            m_waterMerged.end(),
+            m_waterEdits[group].begin(),
+            m_waterEdits[group].end()
+        );
+    }
+
+    // neighbouring cells, in the same chunk or not, can flow into one block,
+    // the strongest flow wins and falling water beats any spread
+    auto strength = [](const WaterEdit &edit) {
+        return edit.level == Chunk::WATER_FALLING ? -1 : edit.level;
+    };
+
+    std::sort(
+        m_waterMerged.begin(),
+        m_waterMerged.end(),
+        [&](const WaterEdit &a, const WaterEdit &b) {
+            return std::make_tuple(a.pos.x, a.pos.y, a.pos.z, strength(a)) <
+                std::make_tuple(b.pos.x, b.pos.y, b.pos.z, strength(b));
+        }
+    );
+
+    for (usize i = 0; i < m_waterMerged.size(); i++) {
+        const auto &edit = m_waterMerged[i];
+
+        if (i > 0 && edit.pos == m_waterMerged[i - 1].pos) {
+            continue;
+        }
+
+        batch.set(edit.pos, edit.type, edit.level);
+    }
+}
+
+void World::flowWaterCell(const glm::ivec3 &pos, std::vector<WaterEdit> &edits) const
+{
+    static const std::array<glm::ivec3, 4> sides = {
+        glm::ivec3(1, 0, 0),
+        glm::ivec3(-1, 0, 0),
+        glm::ivec3(0, 0, 1),
+        glm::ivec3(0, 0, -1)
+    };
+
+    const glm::ivec3 up(0, 1, 0);
+
+    u8 level = getWaterLevel(pos);
+
+    // flowing water takes its level from whatever still feeds it and
+    // dries up once nothing does
+    if (level != Chunk::WATER_SOURCE) {
+        const u8 dry = 0xF;
+        u8 fed = dry;
+
+        if (getBlock(pos + up) == BlockType::WATER) {
+            fed = Chunk::WATER_FALLING;
+        } else {
+            for (const auto &side : sides) {
+                if (getBlock(pos + side) != BlockType::WATER) {
+                    continue;
+                }
+
+                u8 feed = getWaterLevel(pos + side);
+                if (feed == Chunk::WATER_FALLING) {
+                    feed = Chunk::WATER_SOURCE;
+                }
+
+                if (feed < Chunk::WATER_MAX_LEVEL) {
+                    fed = std::min<u8>(fed, feed + 1);
+                }
+            }
+        }
+
+        if (fed == dry) {
+            edits.push_back({pos, BlockType::AIR, 0});
+            return;
+        }
+
+        if (fed != level) {
+            edits.push_back({pos, BlockType::WATER, fed});
+            level = fed;
+        }
+    }
+
+    glm::ivec3 below = pos - up;
+
+    if (below.y < 0) {
+        return;
+    }
+
+    if (canWaterFlowInto(below)) {
+        edits.push_back({below, BlockType::WATER, Chunk::WATER_FALLING});
+        return;
+    }
+
+    if (getBlock(below) == BlockType::WATER) {
+        return;
+    }
+
+    u8 spread = (level == Chunk::WATER_FALLING) ? 1 : level + 1;
+    if (spread > Chunk::WATER_MAX_LEVEL) {
+        return;
+    }
+
+    for (const auto &side : sides) {
+        if (canWaterFlowInto(pos + side)) {
+            edits.push_back({pos + side, BlockType::WATER, spread});
+        }
+    }
+}
+
+bool World::canWaterFlowInto(const glm::ivec3 &pos) const
+{
+    BlockType type = getBlock(pos);
+    return type != BlockType::WATER && !hasFlag(pos, BlockFlag::COLLIDABLE);
+}
+
+void World::tickRandomBlocks(EditBatch &batch)
+{
+    static_assert(
+        RANDOM_TICKS_PER_SECTION * 12 <= 64,
+        "one hash holds the positions of a section"
+    );
+
+    const auto &registry = BlockRegistry::get();
+
+    m_randomTickSections = 0;
+    m_randomTicks = 0;
+
+    for (const auto &[pos, chunk] : m_chunks) {
+        u64 chunkKey = (m_blockTick << 32) ^
+            (static_cast<u64>(static_cast<u32>(pos.x)) * 0x9E3779B97F4A7C15ull) ^
+            (static_cast<u64>(static_cast<u32>(pos.z)) * 0xC2B2AE3D27D4EB4Full);
+
+        for (
+            int section = 0;
+            section < SectionConnectivity::SECTION_COUNT;
+            section++
+        ) {
+            if (!chunk->hasRandomTicks(section)) {
+                continue;
+            }
+
+            m_randomTickSections++;
+
+            u64 bits = mixBits(chunkKey + static_cast<u64>(section));
+
+            for (int i = 0; i < RANDOM_TICKS_PER_SECTION; i++, bits >>= 12) {
+                int x = static_cast<int>(bits & 15);
+                int z = static_cast<int>((bits >> 4) & 15);
+                int y = section * SectionConnectivity::SECTION_SIZE +
+                    static_cast<int>((bits >> 8) & 15);
+
+                BlockType type = chunk->getBlock(x, y, z);
+                if (!registry.getBlock(type).randomTicks) {
+                    continue;
+                }
+
+                m_randomTicks++;
+
+                glm::ivec3 blockPos = {
+                    pos.x * Chunk::CHUNK_SIZE + x,
+                    y,
+                    pos.z * Chunk::CHUNK_SIZE + z
+                };
+
+                runRandomTick(blockPos, type, mixBits(bits ^ chunkKey), batch);
+            }
+        }
+    }
+}
+
+void World::runRandomTick(
+    const glm::ivec3 &pos,
+    BlockType type,
+    u64 random,
+    EditBatch &batch
+)
+{
+    const glm::ivec3 up(0, 1, 0);
+
+    switch (type) {
+    case BlockType::GRASS: {
+        if (hasFlag(pos + up, BlockFlag::OPAQUE)) {
+            batch.set(pos, BlockType::DIRT);
+            break;
+        }
+
+        glm::ivec3 target = pos + glm::ivec3(
+            static_cast<int>(random % 3) - 1,
+            static_cast<int>((random >> 8) % 5) - 3,
+            static_cast<int>((random >> 16) % 3) - 1
+        );
+
+        if (
+            getBlock(target) == BlockType::DIRT &&
+            !hasFlag(target + up, BlockFlag::OPAQUE)
+        ) {
+            batch.set(target, BlockType::GRASS);
+        }
+        break;
+    }
+
+    case BlockType::LEAVES:
+        if (!isBlockNear(pos, LEAF_DECAY_RADIUS, BlockType::LOG)) {
+            batch.set(pos, BlockType::AIR);
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+bool World::isBlockNear(const glm::ivec3 &center, i32 radius, BlockType type) const
+{
+    i32 minY = std::max(center.y - radius, 0);
+    i32 maxY = std::min(center.y + radius, Chunk::CHUNK_HEIGHT - 1);
+
+    ChunkPos currentChunk = {INT_MAX, INT_MAX};
+    const Chunk *chunk = nullptr;
+
+    for (i32 x = center.x - radius; x <= center.x + radius; x++) {
+        for (i32 z = center.z - radius; z <= center.z + radius; z++) {
+            ChunkPos chunkPos = {
+                (x < 0) ? (x - (Chunk::CHUNK_SIZE - 1)) / Chunk::CHUNK_SIZE :
+                    x / Chunk::CHUNK_SIZE,
+                (z < 0) ? (z - (Chunk::CHUNK_SIZE - 1)) / Chunk::CHUNK_SIZE :
+                    z / Chunk::CHUNK_SIZE
+            };
+
+            if (chunkPos != currentChunk) {
+                currentChunk = chunkPos;
+                chunk = getChunk(chunkPos);
+            }
+
+            if (!chunk) {
+                continue;
+            }
+
+            i32 localX = x - (chunkPos.x * Chunk::CHUNK_SIZE);
+            i32 localZ = z - (chunkPos.z * Chunk::CHUNK_SIZE);
+
+            for (i32 y = minY; y <= maxY; y++) {
+                if (chunk->getBlock(localX, y, localZ) == type) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+u64 World::mixBits(u64 key)
+{
+    // splitmix64 finalizer
+    key += 0x9E3779B97F4A7C15ull;
+    key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ull;
+    key = (key ^ (key >> 27)) * 0x94D049BB133111EBull;
+    return key ^ (key >> 31);
+}
+
+void World::copyRegion(
+    const glm::ivec3 &min,
+    const glm::ivec3 &max,
+    Region &region
+) const
+{
+    region.size = glm::max(max - min + 1, glm::ivec3(0));
+    region.blocks.resize(region.size.x * region.size.y * region.size.z);
+    region.levels.resize(region.blocks.size());
+
+    for (int y = 0; y < region.size.y; y++) {
+        for (int z = 0; z < region.size.z; z++) {
+            for (int x = 0; x < region.size.x; x++) {
+                glm::ivec3 pos = min + glm::ivec3(x, y, z);
+                int index = region.getIndex(x, y, z);
+
+                region.blocks[index] = getBlock(pos.x, pos.y, pos.z);
+                region.levels[index] = getWaterLevel(pos);
+            }
+        }
+    }
+}
+
+void World::deleteBlock(const glm::ivec3 &pos)
+{
+    placeBlock(pos, BlockType::AIR);
+}
+
+bool World::raycast(
+    const Ray &ray,
+    f32 maxDistance,
+    RaycastResult &result
+) const
+{
+    ChunkCursor cursor;
+    return traceRay(ray, maxDistance, result, cursor);
+}
+
+usize World::raycast(
+    const std::vector<Ray> &rays,
+    f32 maxDistance,
+    std::vector<RaycastResult> &results
+) const
+{
+    results.resize(rays.size());
+
+    ChunkCursor cursor;
+    usize hits = 0;
+
+    for (usize i = 0; i < rays.size(); i++) {
+        results[i].hit = traceRay(rays[i], maxDistance, results[i], cursor);
+        hits += results[i].hit;
+    }
+
+    return hits;
+}
+
+const Chunk *World::lookupChunk(const ChunkPos &pos, ChunkCursor &cursor) const
+{
+    const i32 mask = ChunkCursor::SIZE - 1;
+    auto &entry = cursor.entries[(pos.z & mask) * ChunkCursor::SIZE + (pos.x & mask)];
+
+    if (entry.pos != pos) {
+        entry.pos = pos;
+        entry.chunk = getChunk(pos);
+    }
+
+    return entry.chunk;
+}
+
+bool World::traceRay(
+    const Ray &ray,
+    f32 maxDistance,
+    RaycastResult &result,
+    ChunkCursor &cursor
+) const
+{
+    glm::vec3 pos = ray.origin;
+    glm::vec3 step = glm::sign(ray.direction);
+    glm::vec3 tDelta = glm::abs(1.0f / ray.direction);
+    glm::vec3 tMax;
+    glm::ivec3 blockPos = glm::floor(pos);
+
+    for (i32 i = 0; i < 3; i++) {
+        if (step[i] > 0) {
+            tMax[i] = ((blockPos[i] + 1) - pos[i]) * tDelta[i];
+        } else {
+            tMax[i] = (pos[i] - blockPos[i]) * tDelta[i];
+        }
+    }
+
+    ChunkPos chunkPos(
+        (blockPos.x < 0) ? (blockPos.x - (Chunk::CHUNK_SIZE - 1)) / Chunk::CHUNK_SIZE :
+            blockPos.x / Chunk::CHUNK_SIZE,
+        (blockPos.z < 0) ? (blockPos.z - (Chunk::CHUNK_SIZE - 1)) / Chunk::CHUNK_SIZE :
+            blockPos.z / Chunk::CHUNK_SIZE
+    );
+
+    const Chunk *chunk = lookupChunk(chunkPos, cursor);
+
+    i32 localX = blockPos.x - chunkPos.x * Chunk::CHUNK_SIZE;
+    i32 localZ = blockPos.z - chunkPos.z * Chunk::CHUNK_SIZE;
+
+    Face hitFace;
+    f32 dist = 0.0f;
+
+    while (dist < maxDistance) {
+        // a column with nothing targetable along the stretch the ray
+        // spends in it is left in one jump through its next x or z side
+        f32 exit = std::min({tMax.x, tMax.z, maxDistance});
+
+        if (tMax.y < exit) {
+            i32 steps = static_cast<i32>(std::ceil((exit - tMax.y) / tDelta.y));
+            i32 lastY = blockPos.y + static_cast<i32>(step.y) * steps;
+
+            if (!chunk || !chunk->anyInColumn(
+                BlockFlag::TARGETABLE,
+                localX,
+                localZ,
+                std::min(blockPos.y, lastY),
+                std::max(blockPos.y, lastY)
+            )) {
+                blockPos.y = lastY;
+                dist = tMax.y + (steps - 1) * tDelta.y;
+                tMax.y += steps * tDelta.y;
+                continue;
+            }
+        }
+
+        if (tMax.x < tMax.y && tMax.x < tMax.z) {
+            blockPos.x += step.x;
+            localX += step.x;
+            dist = tMax.x;
+            tMax.x += tDelta.x;
+            hitFace = (step.x > 0) ? Face::WEST : Face::EAST;
+
+            if (localX < 0 || localX >= Chunk::CHUNK_SIZE) {
+                chunkPos.x += step.x;
+                localX -= static_cast<i32>(step.x) * Chunk::CHUNK_SIZE;
+                chunk = lookupChunk(chunkPos, cursor);
+            }
+        } else if (tMax.y < tMax.z) {
+            blockPos.y += step.y;
+            dist = tMax.y;
+            tMax.y += tDelta.y;
+            hitFace = (step.y > 0) ? Face::BOTTOM : Face::TOP;
+        } else {
+            blockPos.z += step.z;
+            localZ += step.z;
+            dist = tMax.z;
+            tMax.z += tDelta.z;
+            hitFace = (step.z > 0) ? Face::NORTH : Face::SOUTH;
+
+            if (localZ < 0 || localZ >= Chunk::CHUNK_SIZE) {
+                chunkPos.z += step.z;
+                localZ -= static_cast<i32>(step.z) * Chunk::CHUNK_SIZE;
+                chunk = lookupChunk(chunkPos, cursor);
+            }
+        }
+
+        if (
+            (blockPos.y < 0 && step.y <= 0) ||
+            (blockPos.y >= Chunk::CHUNK_HEIGHT && step.y >= 0)
+        ) {
+            return false;
+        }
+
+        if (chunk && chunk->hasFlag(BlockFlag::TARGETABLE, localX, blockPos.y, localZ)) {
+            result.pos = blockPos;
+            result.face = hitFace;
+
+            result.normal = blockPos;
+            switch (hitFace) {
+            case Face::NORTH:
+                result.normal.z--;
+                break;
+            case Face::SOUTH:
+                result.normal.z++;
+                break;
+            case Face::EAST:
+                result.normal.x++;
+                break;
+            case Face::WEST:
+                result.normal.x--;
+                break;
+            case Face::TOP:
+                result.normal.y++;
+                break;
+            case Face::BOTTOM:
+                result.normal.y--;
+                break;
+            }
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool World::checkCollision(const glm::vec3 &min, const glm::vec3 &max)
+{
+    i32 minX = static_cast<i32>(std::floor(min.x));
+    i32 minY = static_cast<i32>(std::floor(min.y));
+    i32 minZ = static_cast<i32>(std::floor(min.z));
+    i32 maxX = static_cast<i32>(std::floor(max.x));
+    i32 maxY = static_cast<i32>(std::floor(max.y));
+    i32 maxZ = static_cast<i32>(std::floor(max.z));
+
+    minY = std::max(minY, 0);
+    maxY = std::min(maxY, Chunk::CHUNK_HEIGHT - 1);
+
+    ChunkPos currentChunk = {INT_MAX, INT_MAX};
+    const Chunk *chunk = nullptr;
+
+    for (int x = minX; x <= maxX; ++x) {
+        for (int z = minZ; z <= maxZ; ++z) {
+            ChunkPos chunkPos = {
+                (x < 0) ? (x - (Chunk::CHUNK_SIZE - 1)) / Chunk::CHUNK_SIZE :
+                    x / Chunk::CHUNK_SIZE,
+                (z < 0) ? (z - (Chunk::CHUNK_SIZE - 1)) / Chunk::CHUNK_SIZE :
+                    z / Chunk::CHUNK_SIZE
+            };
+
+            if (chunkPos.x != currentChunk.x || chunkPos.z != currentChunk.z) {
+                currentChunk = chunkPos;
+                chunk = getChunk(chunkPos);
+            }
+
+            if (!chunk) { continue; }
+
+            i32 localX = x - (chunkPos.x * Chunk::CHUNK_SIZE);
+            i32 localZ = z - (chunkPos.z * Chunk::CHUNK_SIZE);
+
+            if (chunk->anyInColumn(
+                BlockFlag::COLLIDABLE, localX, localZ, minY, maxY
+            )) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void World::gatherColliders(
+    const glm::vec3 &min,
+    const glm::vec3 &max,
+    std::vector<glm::ivec3> &blocks
+) const
+{
+    i32 minX = static_cast<i32>(std::floor(min.x));
+    i32 minY = static_cast<i32>(std::floor(min.y));
+    i32 minZ = static_cast<i32>(std::floor(min.z));
+    i32 maxX = static_cast<i32>(std::floor(max.x));
+    i32 maxY = static_cast<i32>(std::floor(max.y));
+    i32 maxZ = static_cast<i32>(std::floor(max.z));
+
+    minY = std::max(minY, 0);
+    maxY = std::min(maxY, Chunk::CHUNK_HEIGHT - 1);
+
+    ChunkPos currentChunk = {INT_MAX, INT_MAX};
+    const Chunk *chunk = nullptr;
+
+    for (i32 x = minX; x <= maxX; x++) {
+        for (i32 z = minZ; z <= maxZ; z++) {
+            ChunkPos chunkPos = {
+                (x < 0) ? (x - (Chunk::CHUNK_SIZE - 1)) / Chunk::CHUNK_SIZE :
+                    x / Chunk::CHUNK_SIZE,
+                (z < 0) ? (z - (Chunk::CHUNK_SIZE - 1)) / Chunk::CHUNK_SIZE :
+                    z / Chunk::CHUNK_SIZE
+            };
+
+            if (chunkPos != currentChunk) {
+                currentChunk = chunkPos;
+                chunk = getChunk(chunkPos);
+            }
+
+            if (!chunk) {
+                continue;
+            }
+
+            i32 localX = x - (chunkPos.x * Chunk::CHUNK_SIZE);
+            i32 localZ = z - (chunkPos.z * Chunk::CHUNK_SIZE);
+
+            for (i32 word = 0; word < Chunk::COLUMN_WORDS; word++) {
+                u64 bits = chunk->getColumnBits(
+                    BlockFlag::COLLIDABLE, localX, localZ, word, minY, maxY
+                );
+
+                for (i32 y = word * 64; bits; y++, bits >>= 1) {
+                    if (bits & 1) {
+                        blocks.push_back({x, y, z});
+                    }
+                }
+            }
+        }
+    }
+}
+
+Chunk *World::getChunk(const ChunkPos &pos) const
+{
+    if (auto it = m_chunks.find(pos); it != m_chunks.end()) {
+        return it->second.get();
+    }
+
+    return nullptr;
+}
+
+Chunk &World::addChunk(const ChunkPos &pos)
+{
+    auto &chunk = m_chunks[pos];
+    chunk = std::make_unique<Chunk>(*this, pos);
+
+    return *chunk;
+}
+
+void World::buildOffsets()
+{
+    const i32 maxDist = StreamingGovernor::MAX_RENDER_DISTANCE;
+
+    m_offsets.clear();
+
+    for (i32 x = -maxDist; x <= maxDist; x++) {
+        for (i32 z = -maxDist; z <= maxDist; z++) {
+            if (x * x + z * z <= maxDist * maxDist) {
+                m_offsets.push_back({x, z});
+            }
+        }
+    }
+
+    std::sort(
+        m_offsets.begin(),
+        m_offsets.end(),
+        [](const glm::ivec2 &a, const glm::ivec2 &b) {
+            i32 distA = a.x * a.x + a.y * a.y;
+            i32 distB = b.x * b.x + b.y * b.y;
+
+            if (distA != distB) {
+                return distA < distB;
+            }
+
+            return std::atan2(a.y, a.x) < std::atan2(b.y, b.x);
+        }
+    );
+
+    m_offsetCounts.fill(0);
+
+    for (i32 r = 0; r <= maxDist; r++) {
+        m_offsetCounts[r] = std::count_if(
+            m_offsets.begin(),
+            m_offsets.end(),
+            [r](const glm::ivec2 &offset) {
+                return offset.x * offset.x + offset.y * offset.y <= r * r;
+            }
+        );
+    }
+}
+
+void World::updateStreamingSet(const ChunkPos &center, i32 radius)
+{
+    const ChunkPos oldCenter = m_playerChunkPos;
+    const i32 oldRadius = m_renderDistance;
+
+    auto isInside = [](const ChunkPos &pos, const ChunkPos &c, i32 r) {
+        i32 dx = pos.x - c.x;
+        i32 dz = pos.z - c.z;
+        return r >= 0 && dx * dx + dz * dz <= r * r;
+    };
+
+    // a one-chunk step enters about one row of the disk, pooling more
+    // would keep the chunks a shrinking radius let go pinned
+    if (radius != oldRadius) {
+        const usize ring = static_cast<usize>(2 * radius + 1);
+
+        m_chunkPool.setLimit(ring);
+        m_meshPool.setLimit(ring);
+    }
+
+    if (oldRadius >= 0) {
+        for (usize i = 0; i < m_offsetCounts[oldRadius]; i++) {
+            ChunkPos pos = {
+                oldCenter.x + m_offsets[i].x,
+                oldCenter.z + m_offsets[i].y
+            };
+
+            if (!isInside(pos, center, radius)) {
+                m_neededPool.release(m_chunksNeeded, pos);
+                m_fillPool.release(m_fillStarts, pos);
+                unloadChunks(pos);
+            }
+        }
+    }
+
+    m_playerChunkPos = center;
+    m_renderDistance = radius;
+
+    for (usize i = 0; i < m_offsetCounts[radius]; i++) {
+        ChunkPos pos = {
+            center.x + m_offsets[i].x,
+            center.z + m_offsets[i].y
+        };
+
+        if (isInside(pos, oldCenter, oldRadius)) {
+            continue;
+        }
+
+        m_neededPool.acquire(m_chunksNeeded, pos);
+
+        if (!isChunkLoaded(pos)) {
+            m_scheduler.push(pos, ChunkTask::GENERATE, getPriority(pos));
+
+            if (oldRadius >= 0) {
+                m_fillPool.acquire(m_fillStarts, pos)->second = Clock::now();
+            }
+        }
+    }
+}
+
+void World::loadChunks(const ChunkPos &pos)
+{
+    auto &chunk = m_chunkPool.acquire(m_chunks, pos)->second;
+
+    if (chunk) {
+        chunk->reset(pos);
+    } else {
+        chunk = std::make_unique<Chunk>(*this, pos);
+    }
+
+    m_generator.generateChunk(*chunk, pos);
+}
+
+void World::unloadChunks(const ChunkPos &pos)
+{
+    if (auto it = m_meshes.find(pos); it != m_meshes.end()) {
+        it->second->destroy();
+        m_meshPool.release(m_meshes, it);
+    }
+
+    m_geometryPool.release(m_geometries, pos);
+
+    m_chunkPool.release(m_chunks, pos);
+}
+
+bool World::isChunkLoaded(const ChunkPos &pos)
 {
     return m_chunks.find(pos) != m_chunks.end();
 }
@@ -513,16 +1643,178 @@ void World::updateMeshe(const ChunkPos &pos)
         getChunk({pos.x, pos.z + 1})
     };
 
-    UNUSED(neighbors);
-
-    if (auto it = m_meshes.find(pos); it != m_meshes.end()) {
-        it->second->update(*chunk, neighbors);
-    } else {
-        auto mesh = std::make_unique<ChunkMesh>();
+    auto &mesh = m_meshPool.acquire(m_meshes, pos)->second;
+    if (!mesh) {
+        mesh = std::make_unique<ChunkMesh>();
         mesh->init(*m_device);
-        mesh->generate(*chunk, neighbors);
-        m_meshes[pos] = std::move(mesh);
     }
+
+    auto &geometry = m_geometryPool.acquire(m_geometries, pos)->second;
+    if (!geometry) {
+        geometry = std::make_unique<ChunkMesh::Geometry>();
+    }
+
+    auto start = Clock::now();
+
+    mesh->build(*chunk, neighbors, m_faceMasks, *geometry);
+
+    std::chrono::duration<f32, std::micro> elapsed = Clock::now() - start;
+    m_meshTime += (elapsed.count() - m_meshTime) * MESH_SMOOTHING;
+
+    m_meshUpdates++;
+}
+
+void World::pollUploads()
+{
+    for (usize i = 0; i < m_pendingUploads.size();) {
+        auto it = m_meshes.find(m_pendingUploads[i]);
+
+        if (it == m_meshes.end() || it->second->poll()) {
+            m_pendingUploads[i] = m_pendingUploads.back();
+            m_pendingUploads.pop_back();
+            continue;
+        }
+
+        i++;
+    }
+}
+
+bool World::runJob(const ChunkJob &job)
+{
+    switch (job.task)
+    {
+
+    case ChunkTask::GENERATE:
+        if (
+            isChunkLoaded(job.pos) ||
+            m_chunksNeeded.find(job.pos) == m_chunksNeeded.end()
+        ) {
+            return false;
+        }
+
+        loadChunks(job.pos);
+        m_ticker.restore(job.pos, m_blockTick);
+        m_scheduler.push(job.pos, ChunkTask::LIGHT, job.priority, job.deadline);
+        return true;
+
+    case ChunkTask::LIGHT: {
+        Chunk *chunk = getChunk(job.pos);
+        if (!chunk) {
+            return false;
+        }
+
+        bool fresh = m_meshes.find(job.pos) == m_meshes.end();
+
+        chunk->update();
+        m_scheduler.push(job.pos, ChunkTask::MESH, job.priority, job.deadline);
+
+        if (!fresh) {
+            return true;
+        }
+
+        ChunkPos neighbors[4] = {
+            {job.pos.x - 1, job.pos.z},
+            {job.pos.x + 1, job.pos.z},
+            {job.pos.x, job.pos.z - 1},
+            {job.pos.x, job.pos.z + 1}
+        };
+
+        for (const auto &neighborPos : neighbors) {
+            if (m_meshes.find(neighborPos) != m_meshes.end()) {
+                m_scheduler.push(
+                    neighborPos,
+                    ChunkTask::MESH,
+                    getPriority(neighborPos),
+                    job.deadline
+                );
+            }
+        }
+
+        return true;
+    }
+
+    case ChunkTask::MESH:
+        if (!isChunkLoaded(job.pos)) {
+            return false;
+        }
+
+        updateMeshe(job.pos);
+        m_scheduler.push(job.pos, ChunkTask::UPLOAD, job.priority, job.deadline);
+        return true;
+
+    case ChunkTask::UPLOAD: {
+        auto it = m_meshes.find(job.pos);
+        auto geometry = m_geometries.find(job.pos);
+
+        if (it != m_meshes.end() && geometry != m_geometries.end()) {
+            if (!it->second->hasPendingUpload()) {
+                m_pendingUploads.push_back(job.pos);
+            }
+
+            it->second->upload(*geometry->second);
+            m_geometryPool.release(m_geometries, geometry);
+
+            auto fill = m_fillStarts.find(job.pos);
+            if (fill != m_fillStarts.end()) {
+                std::chrono::duration<f32> elapsed =
+                    Clock::now() - fill->second;
+                m_fillTime += (elapsed.count() - m_fillTime) * FILL_SMOOTHING;
+                m_fillPool.release(m_fillStarts, fill);
+            }
+
+            return true;
+        }
+
+        return false;
+    }
+    }
+
+    return false;
+}
+
+void World::updateMemoryStats()
+{
+    if (m_chunks.empty()) {
+        m_cpuBytesPerChunk = 0;
+        m_gpuBytesPerChunk = 0;
+        return;
+    }
+
+    usize cpuBytes = m_chunks.size() * sizeof(Chunk);
+    usize gpuBytes = 0;
+
+    for (const auto &[pos, mesh] : m_meshes) {
+        cpuBytes += sizeof(ChunkMesh);
+        gpuBytes += mesh->getGpuBytes();
+    }
+
+    for (const auto &[pos, geometry] : m_geometries) {
+        cpuBytes += geometry->getCapacityBytes();
+    }
+
+    m_geometryPool.forEach([&](const auto &geometry) {
+        cpuBytes += geometry ? geometry->getCapacityBytes() : 0;
+    });
+
+    m_cpuBytesPerChunk = cpuBytes / m_chunks.size();
+    m_gpuBytesPerChunk = gpuBytes / m_chunks.size();
+}
+
+f32 World::getPriority(const ChunkPos &pos) const
+{
+    glm::vec2 offset = glm::vec2(
+        static_cast<f32>(pos.x) + 0.5f,
+        static_cast<f32>(pos.z) + 0.5f
+    ) - m_focus;
+
+    f32 dist = glm::length(offset);
+    if (dist < 1.0f) {
+        return dist;
+    }
+
+    f32 facing = glm::dot(offset / dist, m_viewDir);
+
+    return dist * (1.0f + VIEW_WEIGHT * (1.0f - facing) * 0.5f);
 }
 
 } // namespace wld
\ No newline at end of file
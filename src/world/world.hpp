@@ -9,17 +9,31 @@
 #include <mutex>
 #include <queue>
 #include <future>
+#include <chrono>
+#include <tuple>
+#include <climits>
 
 #include "chunk.hpp"
 #include "chunk_mesh.hpp"
 #include "block.hpp"
 #include "block_registry.hpp"
 #include "world_generator.hpp"
+#include "streaming_governor.hpp"
+#include "chunk_scheduler.hpp"
+#include "occlusion_culler.hpp"
+#include "face_masks.hpp"
+#include "edit_batch.hpp"
+#include "block_ticker.hpp"
 #include "core/camera/camera.hpp"
 #include "graphics/device.hpp"
 #include "graphics/pipeline.hpp"
 #include "graphics/texture_cache.hpp"
+#include "graphics/query_pool.hpp"
+#include "graphics/hiz_buffer.hpp"
 #include "core/frustum.hpp"
+#include "core/memory/node_pool.hpp"
+#include "core/memory/alloc_counter.hpp"
+#include "core/thread/thread_pool.hpp"
 
 namespace wld
 {
@@ -35,6 +49,7 @@ struct RaycastResult
     glm::ivec3 pos;
     glm::ivec3 normal;
     Face face;
+    bool hit = false;
 };
 
 class World
@@ -44,51 +59,253 @@ public:
     void init(gfx::Device &device, gfx::TextureCache &textureCache);
     void destroy();
 
-    void update(const glm::vec3 &playerPos, f32 dt);
-    void render(const core::Camera &camera, VkCommandBuffer cmd);
+    // workers share block tick work, without them it runs inline
+    void setWorkers(core::ThreadPool *workers);
+
+    void update(
+        const glm::vec3 &playerPos,
+        const glm::vec3 &playerVelocity,
+        const glm::vec3 &viewDir,
+        f32 dt
+    );
+    // prepareRender runs on the main thread, the passes only record draws
+    // and may be recorded concurrently into separate command buffers
+    void prepareRender(const core::Camera &camera);
+
+    // renderOpaque draws the chunks that were visible last frame, cull
+    // tests every chunk against the resulting depth and the remaining
+    // passes draw what survived through indirect draws
+    void renderOpaque(VkCommandBuffer cmd);
+    void cull(VkCommandBuffer cmd, const gfx::Image &depth);
+    void renderOpaqueLate(VkCommandBuffer cmd);
+    void renderTransparent(VkCommandBuffer cmd);
+    void renderCutout(VkCommandBuffer cmd);
+
+    void reportFrameTime(f32 frameTime) { m_governor.reportFrame(frameTime); }
 
     BlockType getBlock(int x, int y, int z) const;
     BlockType getBlock(const glm::ivec3 &pos) const {
         return getBlock(pos.x, pos.y, pos.z);
     }
+
+    bool hasFlag(const glm::ivec3 &pos, BlockFlag flag) const;
+    u8 getWaterLevel(const glm::ivec3 &pos) const;
     
     void placeBlock(const glm::ivec3 &pos, BlockType type);
     void deleteBlock(const glm::ivec3 &pos);
 
-    bool raycast(const Ray &ray, f32 maxDistance, RaycastResult &result);
+    // applies the batch, then relights and remeshes each touched chunk
+    // and remeshes the neighbours of edited borders once; returns how
+    // many chunks changed
+    usize commit(const EditBatch &batch);
+
+    // runs the block updates due this tick, called at the fixed tick rate
+    void tickBlocks();
+
+    // bounds are inclusive
+    void copyRegion(
+        const glm::ivec3 &min,
+        const glm::ivec3 &max,
+        Region &region
+    ) const;
+
+    bool raycast(const Ray &ray, f32 maxDistance, RaycastResult &result) const;
+
+    // traces every ray, sharing chunk lookups between them, and returns
+    // how many hit something
+    usize raycast(
+        const std::vector<Ray> &rays,
+        f32 maxDistance,
+        std::vector<RaycastResult> &results
+    ) const;
     bool checkCollision(const glm::vec3 &min, const glm::vec3 &max);
 
+    // appends the cells of every colliding block overlapping the box
+    void gatherColliders(
+        const glm::vec3 &min,
+        const glm::vec3 &max,
+        std::vector<glm::ivec3> &blocks
+    ) const;
+
     usize getUpdatedChunks() const { return m_updatedChunks; }
+    const StreamingGovernor &getGovernor() const { return m_governor; }
+    f32 getFillTime() const { return m_fillTime; }
+    u64 getTickAllocations() const { return m_tickAllocations; }
+    usize getCpuBytesPerChunk() const { return m_cpuBytesPerChunk; }
+    usize getGpuBytesPerChunk() const { return m_gpuBytesPerChunk; }
+    f32 getMeshTime() const { return m_meshTime; }
+    usize getMissingChunks() const { return m_fillStarts.size(); }
+    usize getLoadedMeshes() const { return m_meshes.size(); }
+    usize getVisibleChunks() const { return m_visible.size(); }
+    usize getVisibleSections() const { return m_visibleSections; }
+    usize getDueBlockTicks() const { return m_dueTicks.size(); }
+    usize getScheduledBlockTicks() const { return m_ticker.getScheduled(); }
+    usize getParkedBlockTicks() const { return m_ticker.getParked(); }
+    f32 getBlockTickTime() const { return m_blockTickTime; }
+    usize getRandomTickSections() const { return m_randomTickSections; }
+    usize getRandomTicks() const { return m_randomTicks; }
+    usize getFlowingWater() const { return m_waterCells.size(); }
+    usize getFlowingWaterChunks() const { return m_waterChunks; }
+
+    u64 getOpaqueFragments() const {
+        return m_statistics.getResult(Q_OPAQUE) +
+            m_statistics.getResult(Q_OPAQUE_LATE);
+    }
+    u64 getTransparentFragments() const {
+        return m_statistics.getResult(Q_TRANSPARENT);
+    }
+    u64 getCutoutFragments() const { return m_statistics.getResult(Q_CUTOUT); }
 
 public:
     Chunk *getChunk(const ChunkPos &pos) const;
 
+    // an empty chunk outside streaming, never meshed or lit, for tools
+    // that only query blocks
+    Chunk &addChunk(const ChunkPos &pos);
+
 
 private:
-    struct ChunkPosHash
-    {
-        std::size_t operator()(const ChunkPos &pos) const {
-            return std::hash<int>()(pos.x) ^ (std::hash<int>()(pos.z) << 1);
-        }
-    };
-    
-    std::unordered_set<ChunkPos, ChunkPosHash> m_chunksNeeded;
-    std::vector<std::pair<ChunkPos, f32>> m_chunksToLoad;
-    std::vector<ChunkPos> m_chunksToUnload;
+    using ChunkSet = std::unordered_set<ChunkPos, ChunkPosHash>;
+
+    ChunkSet m_chunksNeeded;
+
+    std::vector<glm::ivec2> m_offsets;
+    std::array<usize, StreamingGovernor::MAX_RENDER_DISTANCE + 1> m_offsetCounts;
+
+    void buildOffsets();
+    void updateStreamingSet(const ChunkPos &center, i32 radius);
 
     void loadChunks(const ChunkPos &pos);
     void unloadChunks(const ChunkPos &pos);
     bool isChunkLoaded(const ChunkPos &pos);
 
     void updateMeshe(const ChunkPos &pos);
+    void pollUploads();
+
+    std::vector<ChunkPos> m_pendingUploads;
+
+    bool runJob(const ChunkJob &job);
+    f32 getPriority(const ChunkPos &pos) const;
 
     static constexpr int RENDER_DISTANCE = 8;
-    static constexpr int CHUNKS_PER_TICK = 1;
+    static constexpr f32 TICK_BUDGET = 0.002f;
+    static constexpr u64 EDIT_DEADLINE = 0;
+    static constexpr f32 VIEW_WEIGHT = 1.0f;
+    static constexpr f32 REPRIORITIZE_DOT = 0.9f;
+    static constexpr f32 LOOKAHEAD = 2.0f;
+    static constexpr f32 FILL_SMOOTHING = 0.1f;
+    static constexpr f32 MESH_SMOOTHING = 0.05f;
+
+    StreamingGovernor m_governor;
+    ChunkScheduler m_scheduler;
+
+    glm::vec2 m_viewDir = {0.0f, 1.0f};
+    glm::vec2 m_focus = {0.0f, 0.0f};
+    glm::vec2 m_prioritizedFocus = {0.0f, 0.0f};
+
+    using Clock = std::chrono::steady_clock;
+
+    using FillMap = std::unordered_map<ChunkPos,
+        Clock::time_point,
+        ChunkPosHash>;
+
+    FillMap m_fillStarts;
+    f32 m_fillTime = 0.0f;
+
+    u64 m_tickAllocations = 0;
 
-    std::queue<ChunkPos> m_pendingChunks;
-    std::queue<ChunkPos> m_pendingMeshes;
+    usize m_cpuBytesPerChunk = 0;
+    usize m_gpuBytesPerChunk = 0;
+
+    void updateMemoryStats();
 
     usize m_updatedChunks = 0;
+    usize m_meshUpdates = 0;
+
+    FaceMasks m_faceMasks;
+    f32 m_meshTime = 0.0f;
+
+    // small direct mapped cache of chunk lookups for ray traversal
+    struct ChunkCursor
+    {
+        static constexpr i32 SIZE = 4;
+
+        struct Entry
+        {
+            ChunkPos pos = {INT_MAX, INT_MAX};
+            const Chunk *chunk = nullptr;
+        };
+
+        std::array<Entry, SIZE * SIZE> entries;
+    };
+
+    const Chunk *lookupChunk(const ChunkPos &pos, ChunkCursor &cursor) const;
+
+    bool traceRay(
+        const Ray &ray,
+        f32 maxDistance,
+        RaycastResult &result,
+        ChunkCursor &cursor
+    ) const;
+
+    static constexpr f32 BLOCK_TICK_SMOOTHING = 0.05f;
+
+    // schedules the blocks at and around pos that react to changes
+    void notifyNeighbors(const glm::ivec3 &pos);
+    void runBlockTick(const ScheduledTick &tick, EditBatch &batch);
+
+    // samples RANDOM_TICKS_PER_SECTION blocks in every section holding
+    // blocks that take random ticks, positions come 12 bits at a time
+    // from one hash of (tick, chunk, section)
+    void tickRandomBlocks(EditBatch &batch);
+    void runRandomTick(
+        const glm::ivec3 &pos,
+        BlockType type,
+        u64 random,
+        EditBatch &batch
+    );
+
+    bool isBlockNear(const glm::ivec3 &center, i32 radius, BlockType type) const;
+
+    static u64 mixBits(u64 key);
+
+    static constexpr i32 RANDOM_TICKS_PER_SECTION = 3;
+    static constexpr i32 LEAF_DECAY_RADIUS = 4;
+
+    BlockTicker m_ticker;
+    u64 m_blockTick = 0;
+
+    std::vector<ScheduledTick> m_dueTicks;
+    std::vector<glm::ivec3> m_changedBlocks;
+    EditBatch m_tickEdits;
+
+    f32 m_blockTickTime = 0.0f;
+
+    usize m_randomTickSections = 0;
+    usize m_randomTicks = 0;
+
+    struct WaterEdit
+    {
+        glm::ivec3 pos;
+        BlockType type;
+        u8 level;
+    };
+
+    // due water cells are grouped by chunk and flowed in parallel
+    // against the unchanged world; every group writes only its own edit
+    // list, cells spilling over into a neighbouring chunk included, and
+    // the lists are merged into the batch in chunk order
+    void flowWater(EditBatch &batch);
+    void flowWaterCell(const glm::ivec3 &pos, std::vector<WaterEdit> &edits) const;
+    bool canWaterFlowInto(const glm::ivec3 &pos) const;
+
+    core::ThreadPool *m_workers = nullptr;
+
+    std::vector<glm::ivec3> m_waterCells;
+    std::vector<usize> m_waterGroups;
+    std::vector<std::vector<WaterEdit>> m_waterEdits;
+    std::vector<WaterEdit> m_waterMerged;
+    usize m_waterChunks = 0;
 
     gfx::Device *m_device;
 
@@ -101,26 +318,109 @@ private:
 
     std::array<gfx::Pipeline, 3> m_pipelines;
 
+    // chunk.frag render modes, selected through a specialization constant
+    static constexpr u32 RENDER_MODE_ID = 0;
+    static constexpr u32 MODE_OPAQUE = 0;
+    static constexpr u32 MODE_CUTOUT = 1;
+    static constexpr u32 MODE_TRANSLUCENT = 2;
+
+    enum Query
+    {
+        Q_OPAQUE,
+        Q_TRANSPARENT,
+        Q_CUTOUT,
+        Q_OPAQUE_LATE,
+        QUERY_COUNT
+    };
+
+    gfx::QueryPool m_statistics;
+
+    gfx::HiZBuffer m_hiz;
+    OcclusionCuller m_culler;
+    std::array<std::vector<ChunkPos>, gfx::MAX_FRAMES_IN_FLIGHT> m_culledChunks;
+    glm::mat4 m_viewProj = glm::mat4(1.0f);
+
     u32 m_textureID;
 
     struct PushConstants
     {
         alignas(16) glm::mat4 model;
         alignas(4) u32 textureID;
+        alignas(4) f32 fogEnd;
     };
 
     core::Frustum m_frustum;
 
+    struct VisibleChunk
+    {
+        ChunkPos pos;
+        ChunkMesh *mesh;
+        f32 distance;
+        u8 sections;
+        f32 minY, maxY;
+    };
+
+    std::vector<VisibleChunk> m_visible;
+
+    // cave culling: a breadth-first walk from the camera's section through
+    // the faces each section connects, on a grid centred on the camera
+    static constexpr i32 SECTION_GRID_RADIUS = StreamingGovernor::MAX_RENDER_DISTANCE + 1;
+    static constexpr i32 SECTION_GRID_SIZE = 2 * SECTION_GRID_RADIUS + 1;
+    static constexpr u32 NO_FACE = SectionConnectivity::FACE_COUNT;
+
+    struct SectionNode
+    {
+        i32 x, z;
+        i32 section;
+        u32 entry;
+        u8 directions;
+    };
+
+    ChunkPos m_sectionOrigin;
+    std::vector<u8> m_sectionMasks;
+    std::vector<const ChunkMesh *> m_sectionMeshes;
+    std::vector<SectionNode> m_sectionQueue;
+    usize m_visibleSections = 0;
+
+    void findVisibleSections(const glm::vec3 &cameraPos);
+    u8 getVisibleSections(const ChunkPos &pos) const;
+
+    void drawCulled(
+        VkCommandBuffer cmd,
+        PipelineType type,
+        Query query,
+        ChunkMesh::Pass pass,
+        OcclusionCuller::DrawSlot slot,
+        bool backToFront
+    );
+
+    void pushChunk(
+        VkCommandBuffer cmd,
+        PipelineType type,
+        const VisibleChunk &visible
+    );
+
     using ChunkMap = std::unordered_map<ChunkPos,
         std::unique_ptr<Chunk>, 
         ChunkPosHash>;
     using ChunkMeshMap = std::unordered_map<ChunkPos, 
         std::unique_ptr<ChunkMesh>, 
         ChunkPosHash>;
+    using GeometryMap = std::unordered_map<ChunkPos,
+        std::unique_ptr<ChunkMesh::Geometry>,
+        ChunkPosHash>;
 
     ChunkPos m_playerChunkPos;
+    i32 m_renderDistance = -1;
     ChunkMap m_chunks;
     ChunkMeshMap m_meshes;
+    GeometryMap m_geometries;
+
+    core::NodePool<ChunkMap> m_chunkPool;
+    core::NodePool<ChunkMeshMap> m_meshPool;
+    core::NodePool<GeometryMap> m_geometryPool;
+    core::NodePool<ChunkSet> m_neededPool;
+    core::NodePool<FillMap> m_fillPool;
 
     WorldGenerator m_generator;
 };
@@ -139,7 +139,8 @@ void WorldGenerator::generateChunk(Chunk &chunk, const ChunkPos &pos)
 
     std::mt19937 treeRng(m_seed + pos.x * 341873 + pos.z * 132897);
 
-    std::vector<std::pair<int, int>> treesPlaced;
+    thread_local std::vector<std::pair<int, int>> treesPlaced;
+    treesPlaced.clear();
 
     for (int x = 0; x < Chunk::CHUNK_SIZE; ++x) {
         for (int z = 0; z < Chunk::CHUNK_SIZE; ++z) {